@@ -6,6 +6,8 @@ CONFIG -= qt
 
 SOURCES += \
         source/main.cpp \
+        source/resource/file_watcher.cpp \
+        source/resource/mapped_file.cpp \
         source/sdl/instances.cpp \
         source/systems/camerasystem.cpp \
         source/systems/collisionsystem.cpp \
@@ -61,32 +63,48 @@ HEADERS += \
     entt/signal/fwd.hpp \
     entt/signal/sigh.hpp \
     game_scene.hpp \
+    source/component/activation.hpp \
     source/component/ai.hpp \
+    source/component/broadphase.hpp \
     source/component/camera.hpp \
     source/component/colliders.hpp \
     source/component/components.hpp \
     source/component/hierachy.hpp \
     source/component/sprite.hPP \
+    source/component/tilecache.hpp \
     source/component/tilegrid.hpp \
     source/component/tileset.hpp \
     source/component/transform.hpp \
     source/component/vector2d.hpp \
+    source/component/vector2d_batch.hpp \
     source/config.hpp \
     source/core.hpp \
     source/fwd.hpp \
     source/game_scene.hpp \
     source/resource/cache.hpp \
+    source/resource/decode.hpp \
+    source/resource/file_watcher.hpp \
     source/resource/fwd.hpp \
+    source/resource/map_format.hpp \
+    source/resource/mapped_file.hpp \
+    source/resource/skyline.hpp \
+    source/sdl/asset_loader.hpp \
+    source/sdl/atlas.hpp \
     source/sdl/config.hpp \
     source/sdl/events.hpp \
     source/sdl/framerate.hpp \
     source/sdl/fwd.hpp \
     source/sdl/game.hpp \
+    source/sdl/glyph_cache.hpp \
     source/sdl/graphics.hpp \
+    source/sdl/profiler.hpp \
     source/sdl/instances.hpp \
+    source/sdl/parallel.hpp \
     source/sdl/scene.hpp \
+    source/sdl/scheduler.hpp \
     source/sdl/sdl.hpp \
     source/sdl/texture_loader.hpp \
+    source/sdl/threadpool.hpp \
     source/sdl/timer.hpp \
     source/systems/camerasystem.hpp \
     source/systems/collisionsystem.hpp \
@@ -0,0 +1,19 @@
+TEMPLATE = app
+CONFIG += console c++17
+CONFIG -= app_bundle
+CONFIG -= qt
+
+# Compares iteration of views and owning groups used by movement and collision systems.
+
+SOURCES += \
+        source/tools/group_benchmark.cpp
+
+HEADERS += \
+    source/component/activation.hpp \
+    source/component/colliders.hpp \
+    source/component/transform.hpp \
+    source/component/vector2d.hpp \
+    source/component/vector2d_batch.hpp
+
+# SDL2 headers, colliders use SDL_Rect.
+INCLUDEPATH += C:/SDL2/SDL2-2.0.10/include
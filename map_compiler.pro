@@ -0,0 +1,19 @@
+TEMPLATE = app
+CONFIG += console c++17
+CONFIG -= app_bundle
+CONFIG -= qt
+
+# Offline converter from Tiled *.tmx to precompiled *.ssmap maps.
+
+SOURCES += \
+        source/tools/map_compiler.cpp \
+        xml/pugixml.cpp
+
+HEADERS += \
+    source/component/tilegrid.hpp \
+    source/component/tileset.hpp \
+    source/resource/decode.hpp \
+    source/resource/map_format.hpp
+
+# SDL2 headers, tile sets use SDL_Rect.
+INCLUDEPATH += C:/SDL2/SDL2-2.0.10/include
@@ -0,0 +1,131 @@
+#ifndef ACTIVATION_HPP
+#define ACTIVATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../../entt/entity/entity.hpp"
+#include "../../entt/entity/fwd.hpp"
+
+namespace ssecs::component
+{
+/*! @brief Entities enabled and disabled together. */
+enum class ActivationSet : std::uint8_t
+{
+    ALWAYS,
+    GAMEPLAY,
+    MENU,
+    COUNT
+};
+
+/**
+ * @brief The Activation class.
+ * One bit per entity tells if systems process it. Every entity belongs to one set
+ * and switching a set flips bits of its members in place: no components are assigned or removed,
+ * so nothing is allocated and owned groups keep their order.
+ * Systems skip disabled entities with Test, which is a load and a bit test.
+ * @note Test is safe from workers, sets are switched only between phases.
+ */
+class Activation
+{
+public:
+    using size_type = std::size_t;
+
+    /*! @brief Create with every set enabled. */
+    Activation()
+    {
+        m_enabled.fill(true);
+    }
+
+    /**
+     * @brief Put entity in the set, done once on creation, may allocate.
+     * @param entity Entity without a set yet.
+     * @param set Set to join, entity takes its state.
+     */
+    void Add(const entt::entity entity, const ActivationSet set)
+    {
+        auto index = Index(entity);
+        if (index / bits >= m_bits.size())
+        {
+            m_bits.resize(index / bits + 1, 0);
+        }
+        m_sets[Slot(set)].push_back(entity);
+        Assign(index, m_enabled[Slot(set)]);
+        m_version++;
+    }
+
+    /*! @brief Enable every entity of the set. */
+    void Enable(const ActivationSet set) noexcept
+    {
+        Switch(set, true);
+    }
+
+    /*! @brief Disable every entity of the set. */
+    void Disable(const ActivationSet set) noexcept
+    {
+        Switch(set, false);
+    }
+
+    /*! @brief Returns true if the set is enabled. */
+    bool Enabled(const ActivationSet set) const noexcept
+    {
+        return m_enabled[Slot(set)];
+    }
+
+    /*! @brief Returns counter bumped on every change, to rebuild what depends on activation. */
+    size_type Version() const noexcept
+    {
+        return m_version;
+    }
+
+    /*! @brief Returns true if systems should process the entity. */
+    bool Test(const entt::entity entity) const noexcept
+    {
+        auto index = Index(entity);
+        auto word = index / bits;
+        return word < m_bits.size() && (m_bits[word] >> (index % bits) & 1u);
+    }
+
+private:
+    using word_type = std::uint64_t;
+    static constexpr const size_type bits = sizeof(word_type) * 8;
+
+    static size_type Index(const entt::entity entity) noexcept
+    {
+        using traits_type = entt::entt_traits<std::underlying_type_t<entt::entity>>;
+        return static_cast<size_type>(entt::to_integral(entity) & traits_type::entity_mask);
+    }
+
+    static size_type Slot(const ActivationSet set) noexcept
+    {
+        return static_cast<size_type>(set);
+    }
+
+    void Assign(const size_type index, const bool value) noexcept
+    {
+        auto mask = word_type{1} << (index % bits);
+        auto &word = m_bits[index / bits];
+        word = value ? word | mask : word & ~mask;
+    }
+
+    void Switch(const ActivationSet set, const bool value) noexcept
+    {
+        m_enabled[Slot(set)] = value;
+        m_version++;
+        for (auto entity : m_sets[Slot(set)])
+        {
+            Assign(Index(entity), value);
+        }
+    }
+
+    std::vector<word_type> m_bits;
+    std::array<std::vector<entt::entity>, static_cast<size_type>(ActivationSet::COUNT)> m_sets;
+    std::array<bool, static_cast<size_type>(ActivationSet::COUNT)> m_enabled;
+    size_type m_version = 0;
+};
+} // namespace ssecs::component
+
+#endif // ACTIVATION_HPP
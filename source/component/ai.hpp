@@ -34,10 +34,6 @@ struct Health
 {
     int health = 2;
 };
-struct Active
-{
-};
-
 struct View
 {
     float multiplier;
@@ -0,0 +1,152 @@
+#ifndef BROADPHASE_HPP
+#define BROADPHASE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <SDL_rect.h>
+
+#include "../../entt/entity/entity.hpp"
+#include "../../entt/fwd.hpp"
+#include "colliders.hpp"
+
+namespace ssecs::component
+{
+/**
+ * @brief The BroadPhase class.
+ * Uniform grid (spatial hash) of world-space collider rects.
+ * Every rect is inserted in each cell it covers, cells are sorted by key and
+ * only rects sharing a cell are handed out as candidate pairs.
+ * @note Storage is kept between rebuilds, so steady-state updates don't allocate.
+ */
+class BroadPhase
+{
+public:
+    using size_type = std::size_t;
+    using key_type = std::uint64_t;
+
+    /*! @brief Collider registered in the grid. */
+    struct Proxy
+    {
+        entt::entity id;
+        SDL_FRect rect;
+        LayersID layer;
+        int minX, minY, maxX, maxY;
+    };
+
+    BroadPhase() = default;
+    /*! @brief Construct grid with desired cell size in world units. */
+    explicit BroadPhase(const float cellSize) : m_cellSize{cellSize}
+    {
+    }
+
+    /*! @brief Remove all proxies, keeping the allocated storage. */
+    void Clear() noexcept
+    {
+        m_proxies.clear();
+        m_cells.clear();
+    }
+
+    /**
+     * @brief Register collider for current rebuild.
+     * @param id Entity owning the collider.
+     * @param rect World-space rect.
+     * @param layer Collision layer.
+     */
+    void Insert(const entt::entity id, const SDL_FRect &rect, const LayersID layer)
+    {
+        Proxy proxy{id,
+                    rect,
+                    layer,
+                    CellOf(rect.x),
+                    CellOf(rect.y),
+                    CellOf(rect.x + rect.w),
+                    CellOf(rect.y + rect.h)};
+        auto index = static_cast<size_type>(m_proxies.size());
+        m_proxies.push_back(proxy);
+
+        for (int y = proxy.minY; y <= proxy.maxY; y++)
+        {
+            for (int x = proxy.minX; x <= proxy.maxX; x++)
+            {
+                m_cells.emplace_back(Key(x, y), index);
+            }
+        }
+    }
+
+    /**
+     * @brief Invoke func once for each unordered pair of proxies sharing a cell.
+     * A pair is reported only from the first cell of the overlap of both cell ranges,
+     * so proxies spanning several common cells don't produce duplicates.
+     * @tparam Func Invokable with (const Proxy &, const Proxy &).
+     * @param func Callback, lhs is always the proxy inserted first.
+     */
+    template <typename Func>
+    void Pairs(Func func)
+    {
+        std::sort(m_cells.begin(), m_cells.end());
+
+        for (auto first = m_cells.begin(); first != m_cells.end();)
+        {
+            auto last = first;
+            while (last != m_cells.end() && last->first == first->first)
+            {
+                ++last;
+            }
+            auto [x, y] = Cell(first->first);
+
+            for (auto lhs = first; lhs != last; ++lhs)
+            {
+                const auto &a = m_proxies[lhs->second];
+                for (auto rhs = lhs + 1; rhs != last; ++rhs)
+                {
+                    const auto &b = m_proxies[rhs->second];
+                    if (x == std::max(a.minX, b.minX) && y == std::max(a.minY, b.minY))
+                    {
+                        func(a, b);
+                    }
+                }
+            }
+            first = last;
+        }
+    }
+
+    /*! @brief Returns size of cell in world units. */
+    float CellSize() const noexcept
+    {
+        return m_cellSize;
+    }
+
+    /*! @brief Returns count of proxies inserted since last Clear. */
+    size_type Size() const noexcept
+    {
+        return m_proxies.size();
+    }
+
+private:
+    int CellOf(const float coordinate) const noexcept
+    {
+        return static_cast<int>(std::floor(coordinate / m_cellSize));
+    }
+
+    static key_type Key(const int x, const int y) noexcept
+    {
+        return (static_cast<key_type>(static_cast<std::uint32_t>(y)) << 32) | static_cast<std::uint32_t>(x);
+    }
+
+    static std::pair<int, int> Cell(const key_type key) noexcept
+    {
+        return std::make_pair(static_cast<int>(static_cast<std::uint32_t>(key)),
+                              static_cast<int>(static_cast<std::uint32_t>(key >> 32)));
+    }
+
+    float m_cellSize = 128.f;
+    std::vector<Proxy> m_proxies;
+    std::vector<std::pair<key_type, size_type>> m_cells;
+};
+} // namespace ssecs::component
+
+#endif // BROADPHASE_HPP
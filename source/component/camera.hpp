@@ -42,6 +42,12 @@ public:
                 static_cast<int>(std::round(rect.h * m_windowHeight / (2 * viewRadius.y())))};
     }
 
+    /*! @brief Returns visible area in world space. */
+    SDL_FRect WorldRect() const noexcept
+    {
+        return {position.x() - viewRadius.x(), position.y() - viewRadius.y(), 2 * viewRadius.x(), 2 * viewRadius.y()};
+    }
+
     void UpdateWindowSize(SDL_Window *window) noexcept
     {
         SDL_GetWindowSize(window, &m_windowWidth, &m_windowHeight);
@@ -1,8 +1,11 @@
+#include "activation.hpp"
 #include "ai.hpp"
+#include "broadphase.hpp"
 #include "camera.hpp"
 #include "colliders.hpp"
 #include "hierachy.hpp"
 #include "sprite.hpp"
+#include "tilecache.hpp"
 #include "tilegrid.hpp"
 #include "tileset.hpp"
 #include "transform.hpp"
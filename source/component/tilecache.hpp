@@ -0,0 +1,121 @@
+#ifndef TILECACHE_HPP
+#define TILECACHE_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <SDL_render.h>
+
+namespace ssecs::component
+{
+/**
+ * @brief The TileGridCache class.
+ * Pre-rendered chunks of TileGrid, one target texture per non-empty chunk.
+ * Chunk is rendered again only when its TileGrid::Revision changes.
+ * It also remembers what was drawn last to a static layer, see Unchanged.
+ */
+class TileGridCache
+{
+public:
+    struct Chunk
+    {
+        SDL_Texture *texture = nullptr;
+        std::uint32_t revision = 0;
+    };
+
+    TileGridCache() = default;
+    TileGridCache(const TileGridCache &) = delete;
+    TileGridCache &operator=(const TileGridCache &) = delete;
+    TileGridCache(TileGridCache &&other) noexcept
+        : m_chunks{std::move(other.m_chunks)}, m_chunksX{std::exchange(other.m_chunksX, 0)}, m_view{other.m_view},
+          m_revision{other.m_revision}, m_hasView{std::exchange(other.m_hasView, false)}
+    {
+        other.m_chunks.clear();
+    }
+    TileGridCache &operator=(TileGridCache &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            m_chunks = std::move(other.m_chunks);
+            m_chunksX = std::exchange(other.m_chunksX, 0);
+            m_view = other.m_view;
+            m_revision = other.m_revision;
+            m_hasView = std::exchange(other.m_hasView, false);
+            other.m_chunks.clear();
+        }
+        return *this;
+    }
+
+    /*! @brief Invoke reset. */
+    ~TileGridCache()
+    {
+        Reset();
+    }
+
+    /*! @brief Destroy all chunk textures. */
+    void Reset() noexcept
+    {
+        for (auto &chunk : m_chunks)
+        {
+            if (chunk.texture)
+            {
+                SDL_DestroyTexture(chunk.texture);
+            }
+        }
+        m_chunks.clear();
+        m_chunksX = 0;
+        m_hasView = false;
+    }
+
+    /**
+     * @brief Match chunk count of the grid, dropping cache if it changed.
+     * @param x Count of chunk columns.
+     * @param y Count of chunk rows.
+     */
+    void Resize(const int x, const int y)
+    {
+        if (x != m_chunksX || static_cast<std::size_t>(x) * y != m_chunks.size())
+        {
+            Reset();
+            m_chunks.resize(static_cast<std::size_t>(x) * y);
+            m_chunksX = x;
+        }
+    }
+
+    /*! @brief Returns chunk by its column and row. */
+    Chunk &At(const int x, const int y) noexcept
+    {
+        return m_chunks[static_cast<std::size_t>(y) * m_chunksX + x];
+    }
+
+    /**
+     * @brief Check if the last drawn view and grid revision are still current.
+     * @param view Visible world rect.
+     * @param revision TileGrid::Revision().
+     */
+    bool Unchanged(const SDL_FRect &view, const std::uint32_t revision) const noexcept
+    {
+        return m_hasView && m_revision == revision && m_view.x == view.x && m_view.y == view.y &&
+               m_view.w == view.w && m_view.h == view.h;
+    }
+
+    /*! @brief Remember drawn view and grid revision. */
+    void Remember(const SDL_FRect &view, const std::uint32_t revision) noexcept
+    {
+        m_view = view;
+        m_revision = revision;
+        m_hasView = true;
+    }
+
+private:
+    std::vector<Chunk> m_chunks;
+    int m_chunksX = 0;
+    SDL_FRect m_view{};
+    std::uint32_t m_revision = 0;
+    bool m_hasView = false;
+};
+} // namespace ssecs::component
+
+#endif // TILECACHE_HPP
@@ -1,72 +1,455 @@
 #ifndef TILEGRID_HPP
 #define TILEGRID_HPP
 
+#include <algorithm>
+#include <charconv>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <iostream>
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 #include "../../xml/pugixml.hpp"
 
 #include "../config.hpp"
+#include "../resource/decode.hpp"
+#include "../resource/map_format.hpp"
 #include "colliders.hpp"
 #include "tileset.hpp"
 #include "vector2d.hpp"
 
 namespace ssecs::component
 {
+/**
+ * @brief The TileGrid class.
+ * Single layer of tile map.
+ * Cells are kept in one row-major buffer in file order (top row first),
+ * while the accessors count rows from the bottom of the grid (world y grows up).
+ * Non-zero cells are mirrored in a solid bitmap, one bit per cell.
+ */
 class TileGrid
 {
 
 public:
-    using id_type = TileSet::size_type;
-    TileGrid(const pugi::xml_document &xml_doc, TileSet *tileset, id_type layer)
+    using size_type = TileSet::size_type;
+    using id_type = SSECS_TILE_ID_TYPE;
+    using word_type = std::uint32_t;
+
+    static constexpr const int word_bits = 32;
+    /*! @brief Side of square chunk in cells, see Revision. */
+    static constexpr const int chunk_size = SSECS_TILE_CHUNK_SIZE;
+
+    /**
+     * @brief Inclusive range of cells.
+     * Columns count from the left, rows count from the bottom of the grid (world y grows up).
+     */
+    struct CellRange
+    {
+        int left;
+        int right;
+        int bottom;
+        int top;
+
+        bool Empty() const noexcept
+        {
+            return left > right || bottom > top;
+        }
+    };
+
+    TileGrid(const pugi::xml_document &xml_doc, TileSet *tileset, size_type layer)
     {
         SSECS_ASSERT(tileset);
 
         this->tileSet = tileset;
 
         auto map = xml_doc.child("map");
-        auto next_id = static_cast<id_type>(std::stoi(map.attribute("nextlayerid").value()));
+        auto next_id = static_cast<size_type>(std::stoi(map.attribute("nextlayerid").value()));
         SSECS_ASSERT(layer < next_id && layer > 0);
-        this->layer = layer;
+        this->layer = static_cast<int>(layer);
 
+        Resize(std::stoi(map.attribute("width").value()), std::stoi(map.attribute("height").value()));
         {
-            auto width = std::stoi(map.attribute("width").value());
-            auto height = std::stoi(map.attribute("height").value());
+            auto finded = map.find_child_by_attribute("layer", "id", std::to_string(layer).c_str());
+            auto data = finded.child("data");
 
-            cell.resize(height);
-            for (auto &row : cell)
+            std::string_view encoding = data.attribute("encoding").value();
+            std::string_view compression = data.attribute("compression").value();
+            std::string_view text = data.text().get();
+            if (encoding == "csv")
+            {
+                ParseCsv(text);
+            }
+            else if (encoding == "base64")
+            {
+                resource::bytes_type bytes;
+                if (!resource::base64_decode(text, bytes))
+                {
+                    FAST_THROW("Invalid base64 layer data.");
+                }
+                if (!compression.empty())
+                {
+                    resource::bytes_type raw;
+                    raw.reserve(m_cells.size() * 4);
+                    bool result = false;
+                    if (compression == "zlib")
+                    {
+                        result = resource::zlib_decompress(bytes, raw);
+                    }
+                    else if (compression == "gzip")
+                    {
+                        result = resource::gzip_decompress(bytes, raw);
+                    }
+                    if (!result)
+                    {
+                        FAST_THROW("Unsupported or corrupted layer compression.");
+                    }
+                    bytes.swap(raw);
+                }
+                ParseBinary(bytes);
+            }
+            else
             {
-                row.resize(width);
+                FAST_THROW("Unsupported layer encoding.");
             }
         }
+        UpdateSolid();
+    }
+
+    /**
+     * @brief Copy layer from precompiled map.
+     * @param map Valid map view.
+     * @param tileset Tile set of the layer.
+     * @param layer Tiled layer id.
+     */
+    TileGrid(const resource::map_view &map, TileSet *tileset, size_type layer)
+    {
+        SSECS_ASSERT(tileset);
+
+        this->tileSet = tileset;
+        this->layer = static_cast<int>(layer);
+
+        auto &header = map.header();
+        auto entry = map.layer(static_cast<std::uint32_t>(layer));
+        if (!entry)
+        {
+            FAST_THROW("Layer doesn't exist in precompiled map.");
+        }
+        if (header.id_size != sizeof(id_type))
         {
+            FAST_THROW("Precompiled map was built with another tile id type.");
+        }
 
-            auto finded = map.find_child_by_attribute("layer", "id", std::to_string(layer).c_str());
+        Resize(static_cast<int>(header.width), static_cast<int>(header.height));
+        if (header.row_words != static_cast<std::uint32_t>(m_rowWords))
+        {
+            FAST_THROW("Precompiled map has corrupted solid bitmap.");
+        }
+        std::memcpy(m_cells.data(), map.cells(*entry), m_cells.size() * sizeof(id_type));
+        std::memcpy(m_solid.data(), map.solid(*entry), m_solid.size() * sizeof(word_type));
+    }
+
+    /**
+     * @brief Resize grid, all cells become empty.
+     * @param width Count of columns.
+     * @param height Count of rows.
+     */
+    void Resize(const int width, const int height)
+    {
+        m_width = width;
+        m_height = height;
+        m_rowWords = (width + word_bits - 1) / word_bits;
+        m_cells.assign(static_cast<size_type>(width) * height, 0);
+        m_solid.assign(static_cast<size_type>(m_rowWords) * height, 0);
+        m_revisions.assign(static_cast<size_type>(ChunksX()) * ChunksY(), 1);
+        m_revision++;
+    }
+
+    /*! @brief Returns count of columns. */
+    int Width() const noexcept
+    {
+        return m_width;
+    }
+    /*! @brief Returns count of rows. */
+    int Height() const noexcept
+    {
+        return m_height;
+    }
+
+    /**
+     * @brief Returns id of cell.
+     * @param col Column from the left.
+     * @param row Row from the bottom.
+     */
+    id_type At(const int col, const int row) const noexcept
+    {
+        SSECS_ASSERT(Valid(col, row));
+        return m_cells[Index(col, row)];
+    }
+
+    /**
+     * @brief Returns pointer to the first of Width() ids of the row.
+     * @param row Row from the bottom.
+     */
+    const id_type *Row(const int row) const noexcept
+    {
+        SSECS_ASSERT(Valid(0, row));
+        return m_cells.data() + Index(0, row);
+    }
+
+    /*! @brief Returns count of chunk columns. */
+    int ChunksX() const noexcept
+    {
+        return (m_width + chunk_size - 1) / chunk_size;
+    }
+    /*! @brief Returns count of chunk rows. */
+    int ChunksY() const noexcept
+    {
+        return (m_height + chunk_size - 1) / chunk_size;
+    }
+
+    /**
+     * @brief Returns revision of chunk, it changes whenever any of its cells is set.
+     * Chunk (x, y) covers columns from x * chunk_size and rows from y * chunk_size.
+     */
+    std::uint32_t Revision(const int x, const int y) const noexcept
+    {
+        SSECS_ASSERT(x >= 0 && x < ChunksX() && y >= 0 && y < ChunksY());
+        return m_revisions[static_cast<size_type>(y) * ChunksX() + x];
+    }
+
+    /*! @brief Returns revision of the whole grid, it changes whenever any cell is set. */
+    std::uint32_t Revision() const noexcept
+    {
+        return m_revision;
+    }
+
+    /*! @brief Returns raw cells in file order. */
+    const std::vector<id_type> &Cells() const noexcept
+    {
+        return m_cells;
+    }
+
+    /*! @brief Returns raw solid bitmap in file order, RowWords() words per row. */
+    const std::vector<word_type> &SolidWords() const noexcept
+    {
+        return m_solid;
+    }
+
+    /*! @brief Returns count of bitmap words per row. */
+    int RowWords() const noexcept
+    {
+        return m_rowWords;
+    }
 
-            std::string data = finded.child("data").text().get();
+    /**
+     * @brief Set id of cell and update its solid bit.
+     * @param col Column from the left.
+     * @param row Row from the bottom.
+     * @param id Tile id, zero for an empty cell.
+     */
+    void Set(const int col, const int row, const id_type id) noexcept
+    {
+        SSECS_ASSERT(Valid(col, row));
+        m_cells[Index(col, row)] = id;
+
+        auto &word = m_solid[WordIndex(col, row)];
+        auto bit = word_type{1} << (col % word_bits);
+        word = id ? (word | bit) : (word & ~bit);
 
-            for (auto &row : cell)
+        m_revisions[static_cast<size_type>(row / chunk_size) * ChunksX() + col / chunk_size]++;
+        m_revision++;
+    }
+
+    /*! @brief Check if col and row exist in the grid. */
+    bool Valid(const int col, const int row) const noexcept
+    {
+        return col >= 0 && col < m_width && row >= 0 && row < m_height;
+    }
+
+    /*! @brief Returns true if cell is not empty. */
+    bool Solid(const int col, const int row) const noexcept
+    {
+        SSECS_ASSERT(Valid(col, row));
+        return (m_solid[WordIndex(col, row)] >> (col % word_bits)) & 1;
+    }
+
+    /**
+     * @brief Invoke func with column of every solid cell of the row in [left, right].
+     * Empty words are skipped whole.
+     * @tparam Func Invokable with (int col).
+     */
+    template <typename Func>
+    void EachSolid(const int row, const int left, const int right, Func func) const
+    {
+        SSECS_ASSERT(Valid(left, row) && Valid(right, row));
+        auto words = m_solid.data() + WordIndex(0, row);
+        for (int w = left / word_bits; w <= right / word_bits; w++)
+        {
+            auto bits = words[w];
+            auto first = w * word_bits;
+            if (left > first)
             {
-                for (auto &col : row)
-                {
-                    auto pos = data.find_first_of(",");
-                    col = std::stoi(data.substr(0, pos));
+                bits &= ~word_type{0} << (left - first);
+            }
+            if (right < first + word_bits - 1)
+            {
+                bits &= ~word_type{0} >> (first + word_bits - 1 - right);
+            }
+            while (bits)
+            {
+                func(first + LowestBit(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
 
-                    data = data.substr(pos + 1);
+    /*! @brief Rebuild solid bitmap from cells. */
+    void UpdateSolid() noexcept
+    {
+        std::fill(m_solid.begin(), m_solid.end(), 0);
+        for (int row = 0; row < m_height; row++)
+        {
+            auto ids = Row(row);
+            auto words = m_solid.data() + WordIndex(0, row);
+            for (int col = 0; col < m_width; col++)
+            {
+                if (ids[col])
+                {
+                    words[col / word_bits] |= word_type{1} << (col % word_bits);
                 }
             }
         }
     }
 
+    /*! @brief Returns world size of a single cell. */
+    Vector2D CellSize() const noexcept
+    {
+        return {tileSet->TileWidth() * scale.x(), tileSet->TileHeight() * scale.y()};
+    }
+
+    /**
+     * @brief Compute cells touched by world rect, edges included.
+     * @param origin World position of the grid.
+     * @param rect World rect.
+     * @return Range clamped to the grid, may be empty.
+     */
+    CellRange Cover(const Vector2D &origin, const SDL_FRect &rect) const noexcept
+    {
+        auto size = CellSize();
+        auto x = (rect.x - origin.x()) / size.x();
+        auto y = (rect.y - origin.y()) / size.y();
+        CellRange range{static_cast<int>(std::ceil(x - 1)), static_cast<int>(std::floor(x + rect.w / size.x())),
+                        static_cast<int>(std::ceil(y - 1)), static_cast<int>(std::floor(y + rect.h / size.y()))};
+
+        range.left = std::max(range.left, 0);
+        range.bottom = std::max(range.bottom, 0);
+        range.right = std::min(range.right, Width() - 1);
+        range.top = std::min(range.top, Height() - 1);
+        return range;
+    }
+
     int layer;
     TileSet *tileSet;
-    std::vector<std::vector<id_type>> cell;
     Vector2D scale;
     inline static bool hasDebugDraw = false;
+
+private:
+    /*! @brief Tiled stores flip flags in the upper bits of global tile id. */
+    static constexpr const std::uint32_t gid_mask = 0x0fffffff;
+
+    void ParseCsv(std::string_view text)
+    {
+        auto first = text.data();
+        auto last = first + text.size();
+        auto skip = [&first, last]() {
+            while (first != last && (*first == ' ' || *first == '\n' || *first == '\r' || *first == '\t'))
+            {
+                first++;
+            }
+        };
+
+        for (auto &id : m_cells)
+        {
+            skip();
+            std::uint32_t gid = 0;
+            auto [ptr, error] = std::from_chars(first, last, gid);
+            if (error != std::errc{})
+            {
+                FAST_THROW("Invalid csv layer data.");
+            }
+            id = ToId(gid);
+
+            first = ptr;
+            skip();
+            if (first != last && *first == ',')
+            {
+                first++;
+            }
+        }
+    }
+
+    /*! @brief Strip flip flags of Tiled gid, throw if the tile doesn't fit id_type. */
+    static id_type ToId(const std::uint32_t gid)
+    {
+        auto tile = gid & gid_mask;
+        if (tile > std::numeric_limits<id_type>::max())
+        {
+            FAST_THROW("Tile id doesn't fit SSECS_TILE_ID_TYPE.");
+        }
+        return static_cast<id_type>(tile);
+    }
+
+    void ParseBinary(const resource::bytes_type &bytes)
+    {
+        if (bytes.size() != m_cells.size() * 4)
+        {
+            FAST_THROW("Layer data size doesn't match the map size.");
+        }
+        auto data = bytes.data();
+        for (auto &id : m_cells)
+        {
+            auto gid = static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8) |
+                       (static_cast<std::uint32_t>(data[2]) << 16) | (static_cast<std::uint32_t>(data[3]) << 24);
+            id = ToId(gid);
+            data += 4;
+        }
+    }
+
+    size_type Index(const int col, const int row) const noexcept
+    {
+        return static_cast<size_type>(m_height - 1 - row) * m_width + col;
+    }
+    size_type WordIndex(const int col, const int row) const noexcept
+    {
+        return static_cast<size_type>(m_height - 1 - row) * m_rowWords + col / word_bits;
+    }
+    static int LowestBit(const word_type bits) noexcept
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(bits);
+#endif
+    }
+
+    int m_width = 0;
+    int m_height = 0;
+    int m_rowWords = 0;
+    std::vector<id_type> m_cells;
+    std::vector<word_type> m_solid;
+    std::vector<std::uint32_t> m_revisions;
+    std::uint32_t m_revision = 0;
 };
 } // namespace ssecs::component
 
@@ -60,9 +60,9 @@ public:
      * Several Parametrs did't use by this method, but it's easy to make your own tile set description.
      *
      * @param xml_doc Path to xml document.
-     * @param texture Texture of tile sheet.
+     * @param texture Texture of tile sheet, it may be assigned later with AssignTexture.
      */
-    void Load(std::string_view xml_doc, texture_type *texture)
+    void Load(std::string_view xml_doc, texture_type *texture = nullptr)
     {
         pugi::xml_document document;
 
@@ -121,6 +121,17 @@ public:
         }
     }
 
+    /**
+     * @brief Assign texture of tile sheet, when it's loaded apart from xml.
+     * @param texture Texture with the sheet.
+     * @param origin Top left corner of the sheet in texture, like in an atlas.
+     */
+    void AssignTexture(texture_type *texture, const SDL_Point origin = {0, 0}) noexcept
+    {
+        m_texture = texture;
+        m_origin = origin;
+    }
+
     /**
      * @brief Return TileSet texture.
      * @return Texture if it exists, otherwise nullptr.
@@ -189,8 +200,10 @@ public:
      * @param tile Valid tile type.
      * @return True if exist, otherwise false.
      */
-    bool Valid(const tile_type tile) const noexcept
+    bool Valid(tile_type tile) const noexcept
     {
+        tile.x -= m_origin.x;
+        tile.y -= m_origin.y;
         bool size = (tile.w == m_tileWidth && tile.h == m_tileHeight);
         bool in_range = (tile.x > 0 && tile.x + tile.w < m_offset.w) && (tile.y > 0 && tile.y + tile.h < m_offset.h);
         bool integral = std::is_integral_v<decltype((tile.x - m_offset.x) / m_tileWidth)> &&
@@ -219,8 +232,8 @@ public:
     const tile_type &Tile(const size_type row, const size_type column) noexcept
     {
         SSECS_ASSERT(Valid(row, column));
-        m_buffer.x = m_offset.x + static_cast<int>(column) * m_tileWidth;
-        m_buffer.y = m_offset.y + static_cast<int>(row) * m_tileHeight;
+        m_buffer.x = m_origin.x + m_offset.x + static_cast<int>(column) * m_tileWidth;
+        m_buffer.y = m_origin.y + m_offset.y + static_cast<int>(row) * m_tileHeight;
         return m_buffer;
     }
 
@@ -301,6 +314,7 @@ public:
 
 private:
     SDL_Texture *m_texture = nullptr;
+    SDL_Point m_origin{};
     SDL_Rect m_offset{};
     SDL_Rect m_buffer{};
 
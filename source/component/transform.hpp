@@ -3,21 +3,66 @@
 
 #include "../config.hpp"
 #include "vector2d.hpp"
+#include "vector2d_batch.hpp"
 #include <array>
+#include <cstddef>
 #include <fstream>
+#include <type_traits>
 
 namespace ssecs::component
 {
 struct Position
 {
     Vector2D position;
+    /*! @brief Position before the last fixed update, see PositionSnapshot. */
+    Vector2D previous;
     inline static bool hasDebugDraw = false;
+
+    /*! @brief Move without interpolation from the old position. */
+    void Teleport(const Vector2D &to)
+    {
+        position = to;
+        previous = to;
+    }
+
+    /**
+     * @brief Returns position between previous and current.
+     * @param alpha Render interpolation factor, 0 is previous, 1 is current.
+     */
+    Vector2D Interpolated(const float alpha) const noexcept
+    {
+        return previous + (position - previous) * alpha;
+    }
 };
 struct Velocity
 {
     float x;
     float y;
 };
+
+/**
+ * @brief Registry context of MovementUpdate.
+ * PartitionMovement sorts MovementGroup so enabled movers come first in its raw arrays.
+ */
+struct MovementBatch
+{
+    std::size_t enabled = 0;
+    std::size_t size = 0;
+    std::size_t version = 0;
+    bool sorted = false;
+};
+
+/**
+ * @brief Integrate packed arrays of positions and velocities, like raw arrays of an owning group.
+ * Moves position only, previous is left for PositionSnapshot.
+ */
+inline void Integrate(Position *positions, const Velocity *velocities, const std::size_t count, const float dt) noexcept
+{
+    static_assert(std::is_standard_layout_v<Position> && std::is_standard_layout_v<Velocity>);
+    static_assert(sizeof(Position) % sizeof(float) == 0 && sizeof(Velocity) == 2 * sizeof(float));
+    Integrate<sizeof(Position) / sizeof(float), 2>(reinterpret_cast<float *>(positions),
+                                                    reinterpret_cast<const float *>(velocities), count, dt);
+}
 struct MovementSpeed
 {
     float speed;
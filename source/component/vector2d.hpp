@@ -1,8 +1,10 @@
 #ifndef VECTOR2D_HPP
 #define VECTOR2D_HPP
 
+#include <algorithm>
 #include <cmath>
 #include <string>
+#include <type_traits>
 
 namespace ssecs::component
 {
@@ -10,6 +12,8 @@ namespace ssecs::component
 /**
  * @brief The Vector2D class.
  * Representation of 2D vectors and points.
+ * Trivially copyable pair of floats, so pools move it with memcpy and arrays of it
+ * can be processed in batches, see vector2d_batch.hpp.
  */
 class Vector2D
 {
@@ -57,30 +61,29 @@ public:
     constexpr Vector2D(const coordinate_type x, const coordinate_type y) : m_x(x), m_y(y)
     {
     }
-    /*! @brief Copy constructor. */
-    Vector2D(const Vector2D &other)
-    {
-        *this = other;
-    }
-    /*! @brief Default destructor. */
-    ~Vector2D() = default;
 
     /*! @brief Returns x coordinate. */
-    const coordinate_type &x() const noexcept
+    constexpr const coordinate_type &x() const noexcept
     {
         return m_x;
     }
 
     /*! @brief Returns y coordinate. */
-    const coordinate_type &y() const noexcept
+    constexpr const coordinate_type &y() const noexcept
     {
         return m_y;
     }
 
+    /*! @brief Returns squared vector lenght, cheaper than magnitude for comparisons. */
+    constexpr coordinate_type sqrMagnitude() const noexcept
+    {
+        return m_x * m_x + m_y * m_y;
+    }
+
     /*! @brief Compute vector lenght and returns it. */
     const coordinate_type magnitude() const noexcept
     {
-        return std::sqrt(m_x * m_x + m_y * m_y);
+        return std::sqrt(sqrMagnitude());
     }
 
     /*! @brief Returns vector with lenght 1. */
@@ -97,14 +100,14 @@ public:
     }
 
     /*! @brief Set x and y coordinates. */
-    void Set(const coordinate_type x, const coordinate_type y) noexcept
+    constexpr void Set(const coordinate_type x, const coordinate_type y) noexcept
     {
         m_x = x;
         m_y = y;
     }
 
     /*! @brief Check if two vectors are equals. */
-    bool Equals(const Vector2D &lhs, const Vector2D &rhs) const noexcept
+    constexpr bool Equals(const Vector2D &lhs, const Vector2D &rhs) const noexcept
     {
         return lhs == rhs;
     }
@@ -115,65 +118,108 @@ public:
         return "x: " + std::to_string(m_x) + "\t" + "y:" + std::to_string(m_y);
     }
 
-    /*! @brief Copy assgment. */
-    Vector2D &operator=(const Vector2D &other)
-    {
-        if (this != &other)
-        {
-            this->m_x = other.m_x;
-            this->m_y = other.m_y;
-        }
-
-        return *this;
-    }
     /*! @brief Multiplys vector by number. */
-    Vector2D operator*(coordinate_type multiplier) const noexcept
+    constexpr Vector2D operator*(const coordinate_type multiplier) const noexcept
     {
-        Vector2D other(m_x * multiplier, m_y * multiplier);
-        return other;
+        return Vector2D(m_x * multiplier, m_y * multiplier);
     }
     /*! @brief Divides vector by number. */
-    Vector2D operator/(coordinate_type divider) const
+    constexpr Vector2D operator/(const coordinate_type divider) const
     {
-        Vector2D other(m_x / divider, m_y / divider);
-        return other;
+        return Vector2D(m_x / divider, m_y / divider);
     }
 
     /*! @brief Adds to vectors. */
-    Vector2D operator+(const Vector2D &other) const noexcept
+    constexpr Vector2D operator+(const Vector2D &other) const noexcept
     {
-        Vector2D result(m_x + other.m_x, m_y + other.m_y);
-        return result;
+        return Vector2D(m_x + other.m_x, m_y + other.m_y);
     }
 
     /*! @brief Subtracts one vector from another. */
-    Vector2D operator-(const Vector2D &other) const noexcept
+    constexpr Vector2D operator-(const Vector2D &other) const noexcept
     {
-        Vector2D result(m_x - other.m_x, m_y - other.m_y);
-        return result;
+        return Vector2D(m_x - other.m_x, m_y - other.m_y);
+    }
+
+    /*! @brief Returns opposite vector. */
+    constexpr Vector2D operator-() const noexcept
+    {
+        return Vector2D(-m_x, -m_y);
+    }
+
+    constexpr Vector2D &operator+=(const Vector2D &other) noexcept
+    {
+        m_x += other.m_x;
+        m_y += other.m_y;
+        return *this;
+    }
+    constexpr Vector2D &operator-=(const Vector2D &other) noexcept
+    {
+        m_x -= other.m_x;
+        m_y -= other.m_y;
+        return *this;
+    }
+    constexpr Vector2D &operator*=(const coordinate_type multiplier) noexcept
+    {
+        m_x *= multiplier;
+        m_y *= multiplier;
+        return *this;
+    }
+    constexpr Vector2D &operator/=(const coordinate_type divider)
+    {
+        m_x /= divider;
+        m_y /= divider;
+        return *this;
     }
 
     /*! @brief Returns true if two vectors are approximately equal. */
-    bool operator==(const Vector2D &other) const noexcept
+    constexpr bool operator==(const Vector2D &other) const noexcept
     {
         return (m_x == other.m_x && m_y == other.m_y);
     }
 
     /*! @brief Returns false if two vectors are approximately equal. */
-    bool operator!=(const Vector2D &other) const noexcept
+    constexpr bool operator!=(const Vector2D &other) const noexcept
     {
         return !(*this == other);
     }
 
-    static Vector2D Lerp(const Vector2D &a, const Vector2D &b, float t)
+    static constexpr Vector2D Lerp(const Vector2D &a, const Vector2D &b, float t)
     {
         return b * t + a * (1 - t);
     }
 
+    /*! @brief Returns dot product of two vectors. */
+    static constexpr coordinate_type Dot(const Vector2D &lhs, const Vector2D &rhs) noexcept
+    {
+        return lhs.m_x * rhs.m_x + lhs.m_y * rhs.m_y;
+    }
+
+    /*! @brief Returns z of 3D cross product, positive if rhs is counterclockwise from lhs. */
+    static constexpr coordinate_type Cross(const Vector2D &lhs, const Vector2D &rhs) noexcept
+    {
+        return lhs.m_x * rhs.m_y - lhs.m_y * rhs.m_x;
+    }
+
+    /*! @brief Returns value with each coordinate clamped between min and max ones. */
+    static constexpr Vector2D Clamp(const Vector2D &value, const Vector2D &min, const Vector2D &max) noexcept
+    {
+        return Vector2D(std::clamp(value.m_x, min.m_x, max.m_x), std::clamp(value.m_y, min.m_y, max.m_y));
+    }
+
 private:
     coordinate_type m_x;
     coordinate_type m_y;
 };
+
+/*! @brief Scales vector by number. */
+constexpr Vector2D operator*(const Vector2D::coordinate_type multiplier, const Vector2D &vector) noexcept
+{
+    return vector * multiplier;
+}
+
+static_assert(std::is_trivially_copyable_v<Vector2D>);
+static_assert(sizeof(Vector2D) == 2 * sizeof(Vector2D::coordinate_type));
 } // namespace ssecs::component
 
 #endif // VECTOR2D_HPP
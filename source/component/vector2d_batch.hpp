@@ -0,0 +1,250 @@
+#ifndef VECTOR2D_BATCH_HPP
+#define VECTOR2D_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "../config.hpp"
+#include "vector2d.hpp"
+
+#if defined(SSECS_SIMD_SSE)
+#include <xmmintrin.h>
+#if defined(SSECS_SIMD_AVX2)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+#elif defined(SSECS_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace ssecs::component
+{
+static_assert(std::is_standard_layout_v<Vector2D>);
+
+/*! @brief Widest registers batch kernels may use. */
+enum class SimdLevel : std::uint8_t
+{
+    SCALAR,
+    SIMD128, /*!< SSE or NEON. */
+    SIMD256  /*!< AVX2. */
+};
+
+/**
+ * @brief The Simd class.
+ * Picks batch kernels at runtime: AVX2 ones run only if the CPU and OS support them,
+ * otherwise SSE or NEON, if the build has neither, plain loops.
+ */
+class Simd
+{
+public:
+    /*! @brief Returns the widest level the build and the CPU support, detected once. */
+    static SimdLevel Supported() noexcept
+    {
+        static const auto supported = Detect();
+        return supported;
+    }
+
+    /*! @brief Returns level kernels use now. */
+    static SimdLevel Level() noexcept
+    {
+        return m_level;
+    }
+
+    /*! @brief Limit kernels to the level, for comparisons, it's clamped to the supported one. */
+    static void SetLevel(const SimdLevel level) noexcept
+    {
+        m_level = level < Supported() ? level : Supported();
+    }
+
+private:
+    static SimdLevel Detect() noexcept
+    {
+#if defined(SSECS_SIMD_AVX2) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        // OSXSAVE and AVX, then the OS must save ymm registers.
+        auto avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        if (avx && (info[1] & (1 << 5)))
+        {
+            return SimdLevel::SIMD256;
+        }
+#elif defined(SSECS_SIMD_AVX2)
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return SimdLevel::SIMD256;
+        }
+#endif
+#if defined(SSECS_SIMD_SSE) || defined(SSECS_SIMD_NEON)
+        return SimdLevel::SIMD128;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+
+    static inline SimdLevel m_level = Supported();
+};
+
+/*! @brief Plain loop of Integrate, also finishes what SIMD kernels leave. */
+template <std::size_t PositionStride, std::size_t VelocityStride>
+void IntegrateScalar(float *positions, const float *velocities, const std::size_t count, const float dt) noexcept
+{
+    for (std::size_t index = 0; index < count; index++)
+    {
+        auto *pos = positions + index * PositionStride;
+        const auto *vel = velocities + index * VelocityStride;
+        pos[0] += vel[0] * dt;
+        pos[1] += vel[1] * dt;
+    }
+}
+
+#if defined(SSECS_SIMD_AVX2)
+/**
+ * @brief AVX2 kernel of Integrate, four pairs per iteration.
+ * Only packed velocities with packed positions or positions followed by one more pair
+ * (like Position with previous) are supported, see Integrate.
+ */
+template <std::size_t PositionStride, std::size_t VelocityStride>
+SSECS_TARGET_AVX2 void IntegrateAvx2(float *positions, const float *velocities, const std::size_t count,
+                                     const float dt) noexcept
+{
+    static_assert(VelocityStride == 2 && (PositionStride == 2 || PositionStride == 4));
+    const auto step = _mm256_set1_ps(dt);
+    std::size_t index = 0;
+    for (; index + 4 <= count; index += 4)
+    {
+        auto *pos = positions + index * PositionStride;
+        auto vel = _mm256_loadu_ps(velocities + index * 2);
+        if constexpr (PositionStride == 2)
+        {
+            _mm256_storeu_ps(pos, _mm256_add_ps(_mm256_loadu_ps(pos), _mm256_mul_ps(vel, step)));
+        }
+        else
+        {
+            // Spread each velocity under its position and zero lanes of the trailing pair.
+            const auto zero = _mm256_setzero_ps();
+            auto low = _mm256_blend_ps(_mm256_permutevar8x32_ps(vel, _mm256_setr_epi32(0, 1, 0, 0, 2, 3, 0, 0)),
+                                       zero, 0b11001100);
+            auto high = _mm256_blend_ps(_mm256_permutevar8x32_ps(vel, _mm256_setr_epi32(4, 5, 0, 0, 6, 7, 0, 0)),
+                                        zero, 0b11001100);
+            _mm256_storeu_ps(pos, _mm256_add_ps(_mm256_loadu_ps(pos), _mm256_mul_ps(low, step)));
+            _mm256_storeu_ps(pos + 8, _mm256_add_ps(_mm256_loadu_ps(pos + 8), _mm256_mul_ps(high, step)));
+        }
+    }
+    IntegrateScalar<PositionStride, VelocityStride>(positions + index * PositionStride,
+                                                    velocities + index * VelocityStride, count - index, dt);
+}
+#endif
+
+/*! @brief SSE or NEON kernel of Integrate, two pairs per iteration. */
+template <std::size_t PositionStride, std::size_t VelocityStride>
+void Integrate128(float *positions, const float *velocities, const std::size_t count, const float dt) noexcept
+{
+    std::size_t index = 0;
+#if defined(SSECS_SIMD_SSE)
+    const auto step = _mm_set1_ps(dt);
+    for (; index + 2 <= count; index += 2)
+    {
+        auto *first = positions + index * PositionStride;
+        auto *second = first + PositionStride;
+        const auto *velocity = velocities + index * VelocityStride;
+
+        __m128 pos;
+        if constexpr (PositionStride == 2)
+        {
+            pos = _mm_loadu_ps(first);
+        }
+        else
+        {
+            pos = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(first)),
+                               reinterpret_cast<const __m64 *>(second));
+        }
+        __m128 vel;
+        if constexpr (VelocityStride == 2)
+        {
+            vel = _mm_loadu_ps(velocity);
+        }
+        else
+        {
+            vel = _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(velocity)),
+                               reinterpret_cast<const __m64 *>(velocity + VelocityStride));
+        }
+
+        pos = _mm_add_ps(pos, _mm_mul_ps(vel, step));
+        if constexpr (PositionStride == 2)
+        {
+            _mm_storeu_ps(first, pos);
+        }
+        else
+        {
+            _mm_storel_pi(reinterpret_cast<__m64 *>(first), pos);
+            _mm_storeh_pi(reinterpret_cast<__m64 *>(second), pos);
+        }
+    }
+#elif defined(SSECS_SIMD_NEON)
+    if constexpr (PositionStride == 2 && VelocityStride == 2)
+    {
+        for (; index + 2 <= count; index += 2)
+        {
+            auto *pos = positions + index * 2;
+            vst1q_f32(pos, vmlaq_n_f32(vld1q_f32(pos), vld1q_f32(velocities + index * 2), dt));
+        }
+    }
+    else
+    {
+        for (; index < count; index++)
+        {
+            auto *pos = positions + index * PositionStride;
+            vst1_f32(pos, vmla_n_f32(vld1_f32(pos), vld1_f32(velocities + index * VelocityStride), dt));
+        }
+    }
+#endif
+    IntegrateScalar<PositionStride, VelocityStride>(positions + index * PositionStride,
+                                                    velocities + index * VelocityStride, count - index, dt);
+}
+
+/**
+ * @brief Add velocities multiplied by dt to positions, both are x, y pairs of floats.
+ * The kernel is picked by Simd::Level: AVX2 takes four pairs per register, SSE and NEON two.
+ * @tparam PositionStride Floats from one position to the next one, 2 for packed pairs.
+ * @tparam VelocityStride Floats from one velocity to the next one, 2 for packed pairs.
+ * @param positions First position x.
+ * @param velocities First velocity x, must not overlap positions.
+ * @param count Count of pairs.
+ * @param dt Delta time.
+ */
+template <std::size_t PositionStride = 2, std::size_t VelocityStride = 2>
+void Integrate(float *positions, const float *velocities, const std::size_t count, const float dt) noexcept
+{
+    static_assert(PositionStride >= 2 && VelocityStride >= 2);
+    switch (Simd::Level())
+    {
+#if defined(SSECS_SIMD_AVX2)
+    case SimdLevel::SIMD256:
+        if constexpr (VelocityStride == 2 && (PositionStride == 2 || PositionStride == 4))
+        {
+            IntegrateAvx2<PositionStride, VelocityStride>(positions, velocities, count, dt);
+            return;
+        }
+        [[fallthrough]];
+#endif
+    case SimdLevel::SIMD128:
+        Integrate128<PositionStride, VelocityStride>(positions, velocities, count, dt);
+        return;
+    default:
+        IntegrateScalar<PositionStride, VelocityStride>(positions, velocities, count, dt);
+    }
+}
+
+/*! @brief Add velocities multiplied by dt to positions, arrays must not overlap. */
+inline void Integrate(Vector2D *positions, const Vector2D *velocities, const std::size_t count,
+                      const float dt) noexcept
+{
+    Integrate(reinterpret_cast<float *>(positions), reinterpret_cast<const float *>(velocities), count, dt);
+}
+} // namespace ssecs::component
+
+#endif // VECTOR2D_BATCH_HPP
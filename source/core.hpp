@@ -21,14 +21,36 @@ using namespace ssecs;
 using namespace component;
 
 inline entt::registry registry{};
-inline sdl::TextureCache textureCache;
+inline sdl::ThreadPool threadPool;
+inline Activation activation;
+inline sdl::Atlas atlas;
 inline sdl::FontCache fontCache;
+inline sdl::GlyphCache font23Glyphs;
+inline sdl::GlyphCache font35Glyphs;
 inline sdl::MusicCache musicCache;
+// Declared after atlas and caches, so its thread stops before they are destroyed.
+inline sdl::AssetLoader assetLoader;
 inline TileSet tileset;
 inline TileSet spriteSheet;
 inline ScoreTable scoreTable;
 inline bool isMenu = false;
 
+/**
+ * Owning groups of the hottest component sets, their owned components are packed
+ * and iterated linearly. GameScene creates them before any entity, systems use these getters.
+ * A component can be owned by one group only, don't create other groups owning them.
+ */
+/*! @brief Entities that move, owns Position and Velocity. Skip ones activation disables. */
+inline auto MovementGroup()
+{
+    return registry.group<Position, Velocity>();
+}
+/*! @brief Entities that collide, owns RectCollider and CollisionLayer. Skip ones activation disables. */
+inline auto ColliderGroup()
+{
+    return registry.group<RectCollider, CollisionLayer>(entt::get<Position>);
+}
+
 using collision_type = void(CollisionData, CollisionData);
 using collision_signal = entt::sigh<collision_type>;
 using collision_sink = entt::sink<collision_type>;
@@ -2,16 +2,25 @@
 #define GAME_PROCESS_HPP
 
 #include "core.hpp"
+#include "resource/file_watcher.hpp"
 #include "systems/systems.hpp"
 
+#include <algorithm>
 #include <filesystem>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "xml/pugixml.hpp"
 #include <random>
 
-constexpr const auto tileid = "tileset";
-constexpr const auto spriteid = "spritesheet";
+constexpr const auto tileid = "tileset"_hs;
+constexpr const auto spriteid = "spritesheet"_hs;
 class GameScene : public sdl::BasicScene
 {
 public:
@@ -20,78 +29,303 @@ public:
     }
     GameScene()
     {
+        MovementGroup();
+        ColliderGroup();
+
         auto &signal = registry.set<collision_signal>();
         auto &sink = registry.set<collision_sink>(signal);
+        registry.set<BroadPhase>();
+        registry.set<MovementBatch>();
         sink.connect<&NullVelocity>();
         sink.connect<&EnemyCharging>();
         sink.connect<&OnHit>();
 
+        auto &dispatcher = sdl::Events::Dispatcher();
+        dispatcher.sink<sdl::KeyDown>().connect<&CameraUpdateDebug>();
+
         if (Mix_OpenAudio(44110, MIX_DEFAULT_FORMAT, 2, 2048) < 0)
         {
             SDL_THROW();
         }
-        auto music = musicCache.load("main", sdl::ResourceLoader::Music("resources/mix/main.mp3"));
-        Mix_PlayMusic(music, -1);
-        textureCache.load(tileid, sdl::ResourceLoader::Sprite("resources/sprites/tilemap.png"));
-        textureCache.load(spriteid, sdl::ResourceLoader::Sprite("resources/sprites/spritesheet.png"));
-
-        fontCache.load("font23", sdl::ResourceLoader::Font("resources/fonts/dpcomic"
-                                                           ".ttf",
-                                                           23));
-        fontCache.load("font35", sdl::ResourceLoader::Font("resources/fonts/dpcomic"
-                                                           ".ttf",
-                                                           35));
-
         scoreTable.Open("resources/score.txt");
-
-        spriteSheet.Load("resources/tiled_files/sprite.tsx", textureCache.resource(spriteid));
-        tileset.Load("resources/tiled_files/tile.tsx", textureCache.resource(tileid));
+        atlas.Create(atlas_size, atlas_size);
         CameraCreate();
-        GridCreate();
-        PlayerCreate();
-        EnemyCreate(Enemy::spawns[0]);
-        EnemyCreate(Enemy::spawns[1]);
-        EnemyCreate(Enemy::spawns[2]);
-        EnemyCreate(Enemy::spawns[3]);
-        EnemyCreate(Enemy::spawns[4]);
-        EnemyCreate(Enemy::spawns[5]);
-        Enemy::currentSpawn = 6;
-
-        CreateLabels();
+        activation.Disable(ActivationSet::MENU);
+
+        LoadAssets();
+
+        threadPool.Start(SSECS_WORKER_COUNT);
+        ScheduleSystems();
     }
 
-    void FixedUpdate() override
+    void FixedUpdate(const float dt) override
     {
-        UpdateView();
-        CameraFollow();
-        CollisionDetection();
-        HealthUpdate();
+        if (m_stage != Stage::READY)
+        {
+            return;
+        }
+        // Reorders movers, so it runs before the phase.
+        PartitionMovement();
+        m_fixedUpdate.Run(dt);
     }
     void Update(const float dt) override
     {
-        CollisionTileDetection(dt);
-        AnimationUpdate(dt);
-        MovementUpdate(dt);
-        EnemyWalking(dt);
-        PlayerMovement(dt);
-        PlayerAttack(dt);
-        ParticleUpdate(dt);
-    }
-    void InputUpdate() override
-    {
-        CameraUpdateDebug();
-        OpenGame();
-        DebugMode();
+        assetLoader.Upload(upload_budget);
+        if (m_stage != Stage::READY)
+        {
+            ContinueLoading();
+            return;
+        }
+        ReloadAssets();
+        m_update.Run(dt);
     }
 
-    void Render() override
+    void Render(const float alpha) override
     {
+        if (m_stage == Stage::ASSETS)
+        {
+            return;
+        }
+        CameraFollow(alpha);
         GridRender();
-        SpriteRender();
+        SpriteRender(alpha);
         PositionDebug();
         RectDebug();
         LabelsRender();
+        LayersDebug();
+        ProfilerDebug();
+    }
+
+private:
+    /*! @brief Milliseconds of texture uploads per frame while assets arrive. */
+    static constexpr const double upload_budget = 4.0;
+    /*! @brief Side of the atlas with sheets and glyphs. */
+    static constexpr const int atlas_size = 1024;
+
+    static constexpr const char *tile_set_path = "resources/tiled_files/tile.tsx";
+    static constexpr const char *sprite_set_path = "resources/tiled_files/sprite.tsx";
+    static constexpr const char *tile_sheet_path = "resources/sprites/tilemap.png";
+    static constexpr const char *sprite_sheet_path = "resources/sprites/spritesheet.png";
+
+    /*! @brief What is loaded, every stage needs the previous one. */
+    enum class Stage
+    {
+        ASSETS, /*!< Nothing to show yet. */
+        WORLD,  /*!< Map and entities are created, waiting for fonts. */
+        LABELS, /*!< Labels are created, waiting for the rest of uploads. */
+        READY   /*!< Everything is loaded, the game runs. */
+    };
+
+    /**
+     * @brief Queue every asset to the loader, frames go on meanwhile.
+     * Sheets go first, they are needed to create the world.
+     */
+    void LoadAssets()
+    {
+        assetLoader.Start();
+        m_tileSets = assetLoader.Async([] {
+            std::pair<TileSet, TileSet> sets;
+            sets.first.Load(tile_set_path);
+            sets.second.Load(sprite_set_path);
+            return sets;
+        });
+        assetLoader.Texture(atlas, tileid, tile_sheet_path);
+        assetLoader.Texture(atlas, spriteid, sprite_sheet_path);
+        m_fonts = assetLoader.Async([] {
+            return std::pair{sdl::ResourceLoader::Font("resources/fonts/dpcomic.ttf", 23),
+                             sdl::ResourceLoader::Font("resources/fonts/dpcomic.ttf", 35)};
+        });
+        m_music = assetLoader.Async([] { return sdl::ResourceLoader::Music("resources/mix/main.mp3"); });
+    }
+
+    /*! @brief Move to next stages whose assets arrived, rethrows errors of loading. */
+    void ContinueLoading()
+    {
+        if (m_stage == Stage::ASSETS && sdl::AssetLoader::Ready(m_tileSets) && atlas.Has(tileid) &&
+            atlas.Has(spriteid))
+        {
+            // Sheets are moved to atlas space, so sprites created from them are too.
+            std::tie(tileset, spriteSheet) = m_tileSets.get();
+            AssignSheets();
+
+            GridCreate();
+            PlayerCreate();
+            EnemyCreate(Enemy::spawns[0]);
+            EnemyCreate(Enemy::spawns[1]);
+            EnemyCreate(Enemy::spawns[2]);
+            EnemyCreate(Enemy::spawns[3]);
+            EnemyCreate(Enemy::spawns[4]);
+            EnemyCreate(Enemy::spawns[5]);
+            Enemy::currentSpawn = 6;
+            m_stage = Stage::WORLD;
+        }
+        if (m_stage == Stage::WORLD && sdl::AssetLoader::Ready(m_fonts))
+        {
+            auto [font23, font35] = m_fonts.get();
+            fontCache.load("font23"_hs, font23);
+            fontCache.load("font35"_hs, font35);
+
+            // Glyphs are rasterized by the loader, fonts aren't touched on this thread.
+            assetLoader.Glyphs(atlas, font23Glyphs, font23, "font23"_hs);
+            assetLoader.Glyphs(atlas, font35Glyphs, font35, "font35"_hs);
+            CreateLabels();
+            m_stage = Stage::LABELS;
+        }
+        if (sdl::AssetLoader::Ready(m_music))
+        {
+            Mix_PlayMusic(musicCache.load("main"_hs, m_music.get()), -1);
+            m_music = {};
+        }
+        if (m_stage == Stage::LABELS && !m_music.valid() && assetLoader.Idle())
+        {
+            auto &dispatcher = sdl::Events::Dispatcher();
+            dispatcher.sink<sdl::KeyDown>().connect<&OpenGame>();
+            dispatcher.sink<sdl::KeyDown>().connect<&DebugMode>();
+            WatchAssets();
+            m_stage = Stage::READY;
+        }
+    }
+
+    /*! @brief Point tile sets to their sheets in the atlas. */
+    static void AssignSheets()
+    {
+        auto tiles = atlas.Rect(tileid);
+        auto sprites = atlas.Rect(spriteid);
+        tileset.AssignTexture(atlas.Texture(), {tiles.x, tiles.y});
+        spriteSheet.AssignTexture(atlas.Texture(), {sprites.x, sprites.y});
     }
+
+    /*! @brief Watch files of loaded assets for hot reload. */
+    void WatchAssets()
+    {
+#ifndef SSECS_DISABLE_HOT_RELOAD
+        for (auto path : {tile_set_path, sprite_set_path, tile_sheet_path, sprite_sheet_path, compiled_map, tmx_map})
+        {
+            m_watcher.watch(path);
+        }
+#endif
+    }
+
+    /**
+     * @brief Run load on the loader thread and apply its result on the main thread once it's ready.
+     * Failed reloads are reported and skipped, the game goes on with old assets.
+     */
+    template <typename Load, typename Apply>
+    void Reload(std::string path, Load &&load, Apply &&apply)
+    {
+        auto future = assetLoader.Async(std::forward<Load>(load));
+        m_reloads.push_back([path = std::move(path), future, apply = std::forward<Apply>(apply)] {
+            if (!sdl::AssetLoader::Ready(future))
+            {
+                return false;
+            }
+            try
+            {
+                apply(future.get());
+            }
+            catch (const std::exception &e)
+            {
+                std::cerr << "Reload of " << path << " failed: " << e.what() << std::endl;
+            }
+            return true;
+        });
+    }
+
+    /**
+     * @brief Reload changed assets in place, entities keep their handles and components.
+     * Files are decoded and parsed on the loader thread, results are swapped in here,
+     * before the phase, so no system sees them half done.
+     * A sheet keeps its atlas space if it still fits, sprites already created keep their rects,
+     * so a grown sprite sheet or a changed sprite.tsx shows on new entities only.
+     */
+    void ReloadAssets()
+    {
+        m_changed.clear();
+        m_watcher.poll(m_changed);
+        for (auto &path : m_changed)
+        {
+            if (path == tile_sheet_path || path == sprite_sheet_path)
+            {
+                auto id = path == tile_sheet_path ? tileid : spriteid;
+                Reload(
+                    path,
+                    [path] {
+                        return std::shared_ptr<SDL_Surface>{sdl::Atlas::Convert(sdl::ResourceLoader::Image(path)),
+                                                            SDL_FreeSurface};
+                    },
+                    [id](const std::shared_ptr<SDL_Surface> &surface) {
+                        atlas.Insert(id, surface.get());
+                        AssignSheets();
+                        GridRefresh();
+                    });
+            }
+            else if (path == tile_set_path || path == sprite_set_path)
+            {
+                auto &set = path == tile_set_path ? tileset : spriteSheet;
+                Reload(
+                    path,
+                    [path] {
+                        TileSet loaded;
+                        loaded.Load(path);
+                        return loaded;
+                    },
+                    [&set](const TileSet &loaded) {
+                        // Grids keep pointers to the global sets, so they use new lookups right away.
+                        set = loaded;
+                        AssignSheets();
+                        GridRefresh();
+                    });
+            }
+            else if (path == compiled_map || path == tmx_map)
+            {
+                // Edited tmx is parsed as is, the compiled map is behind it until map_compiler runs again.
+                auto compiled = path == compiled_map;
+                Reload(
+                    path, [compiled] { return GridLoad(compiled); },
+                    [](const std::vector<TileGrid> &grids) { GridReload(grids); });
+            }
+        }
+        m_reloads.erase(std::remove_if(m_reloads.begin(), m_reloads.end(), [](auto &apply) { return apply(); }),
+                        m_reloads.end());
+    }
+
+    /**
+     * @brief Systems run in order they are added, declared components decide what may overlap.
+     * Activation is switched only between phases, so it isn't declared.
+     */
+    void ScheduleSystems()
+    {
+        using sdl::Read;
+        using sdl::Write;
+
+        m_fixedUpdate.Add(Read<>{}, Write<Position>{}, [](float) { PositionSnapshot(); });
+        m_fixedUpdate.Add(Read<Hierarchy, RectCollider, View>{}, Write<Position>{}, [](float) { UpdateView(); });
+        m_fixedUpdate.AddExclusive([](float) { CollisionDetection(); });
+        m_fixedUpdate.Add(Read<Enemy>{}, Write<Health, Position>{}, [](float) { HealthUpdate(); });
+        m_fixedUpdate.Add(Read<RectCollider, Position, CollisionLayer, TileGridCollider, TileGrid>{},
+                          Write<Velocity>{}, &CollisionTileDetection);
+        m_fixedUpdate.Add(Read<Velocity>{}, Write<Position>{}, &MovementUpdate);
+        m_fixedUpdate.Add(Read<MovementSpeed>{}, Write<Enemy, Velocity>{}, &EnemyWalking);
+        m_fixedUpdate.Add(Read<Player, MovementSpeed, entt::tag<"dash"_hs>>{},
+                          Write<Velocity, AnimationPool, Sprite, Dash, Label>{}, &PlayerMovement);
+        m_fixedUpdate.Add(Read<Hierarchy, Velocity, RectCollider>{},
+                          Write<Player, Position, AnimationPool, Sprite>{}, &PlayerAttack);
+
+        m_update.Add(Read<>{}, Write<AnimationPool, Sprite>{}, &AnimationUpdate);
+        m_update.Add(Read<>{}, Write<ParticleData, Tint>{}, &ParticleUpdate);
+    }
+
+    sdl::Scheduler m_fixedUpdate{registry, threadPool};
+    sdl::Scheduler m_update{registry, threadPool};
+
+    Stage m_stage = Stage::ASSETS;
+    std::shared_future<std::pair<TileSet, TileSet>> m_tileSets;
+    std::shared_future<std::pair<TTF_Font *, TTF_Font *>> m_fonts;
+    std::shared_future<Mix_Music *> m_music;
+
+    resource::file_watcher m_watcher;
+    std::vector<std::string> m_changed;
+    std::vector<std::function<bool()>> m_reloads;
 };
 
 #endif // GAME_PROCESS_HPP
@@ -17,6 +17,9 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[])
         game->CreateScene<GameScene>();
         game->Run();
 
+        assetLoader.Stop();
+        atlas.Reset();
+        registry.clear<TileGridCache>();
         fontCache.reset();
         musicCache.reset();
         scoreTable.Save("score.txt");
@@ -28,6 +31,9 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[])
     {
         std::cerr << e.what() << std::endl;
 
+        assetLoader.Stop();
+        atlas.Reset();
+        registry.clear<TileGridCache>();
         fontCache.reset();
         Instances::DestroyGame();
         return 1;
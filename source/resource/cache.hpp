@@ -1,18 +1,46 @@
 #ifndef CACHE_HPP
 #define CACHE_HPP
 
-#include <array>
-#include <cassert>
-#include <functional>
-#include <map>
-#include <string>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
 #include <type_traits>
+#include <vector>
+
+#include "../../entt/core/hashed_string.hpp"
 
 namespace ssecs::resource
 {
+/**
+ * @brief Reference to a resource slot of a cache.
+ * Stays valid while the id is loaded, also across reloads of the id.
+ * Once the id is erased the slot generation changes and the handle turns stale.
+ */
+struct handle
+{
+    /*! @brief Index of null handles. */
+    static constexpr const std::uint32_t null = ~std::uint32_t{0};
+
+    std::uint32_t index = null;
+    std::uint32_t generation = 0;
+
+    /*! @brief Returns false for default constructed handles. */
+    explicit operator bool() const noexcept
+    {
+        return index != null;
+    }
+};
+
 /**
  * @brief Resource container.
- * @tparam Resourcs Resource type.
+ * Resources are identified by hashed strings, see entt::hashed_string, and stored in slots.
+ * Ids are found with an open-addressing table, so a lookup is a hash and a few probes without allocations.
+ * Hot paths should keep a handle instead, resolving it is a generation check and an index.
+ * String overloads are kept for convenience, they hash the string and forward.
+ * @note Different strings with the same hash name the same resource.
+ * @tparam Resource Resource type.
  * @tparam Eraser Function invokable with erasing.
  */
 template <typename Resource, void (*Eraser)(Resource) = nullptr>
@@ -24,20 +52,36 @@ public:
     using size_type = std::size_t;
     /*! @brief Type of resources managed by a cache. */
     using resource_type = Resource;
-    /*! @brief Unique identifier type for resources. */
-    using id_type = std::string;
+    /*! @brief Unique identifier type for resources, hash of the name. */
+    using id_type = entt::hashed_string::hash_type;
+    /*! @brief Stable reference to a loaded resource. */
+    using handle_type = resource::handle;
     /*! @brief Erase function type. */
     using eraser_type = void (*)(resource_type);
 
     /*! @brief Default constructor. */
     cache() = default;
 
+    /*! @brief Resources are erased once, copies are not allowed. */
+    cache(const cache &) = delete;
+    cache &operator=(const cache &) = delete;
+
     /*! @brief Invoke reset */
     ~cache()
     {
         reset();
     }
 
+    /**
+     * @brief Hash name the way entt::hashed_string does, so "name"_hs matches.
+     * @param name Name of resource.
+     * @return Id of resource.
+     */
+    static id_type hash(const std::string_view name) noexcept
+    {
+        return entt::hashed_string::value(name.data(), name.size());
+    }
+
     /**
      * @brief Get erase templated function.
      * @return Pointer to templated function.
@@ -49,11 +93,11 @@ public:
 
     /**
      * @brief Return count of resources.
-     * @return Size of iternal map.
+     * @return Count of loaded ids.
      */
     size_type size() const noexcept
     {
-        m_resources.size();
+        return m_size;
     }
 
     /**
@@ -62,37 +106,97 @@ public:
      */
     bool empty() const noexcept
     {
-        m_resources.empty();
+        return m_size == 0;
     }
 
-    /*! @brief Reset cache */
+    /*! @brief Reset cache, every handle turns stale. */
     void reset()
     {
-        if constexpr (Eraser)
+        for (std::uint32_t index = 0; index < m_slots.size(); index++)
         {
-            for (auto &[id, resource] : m_resources)
+            if (m_slots[index].used)
             {
-                Eraser(resource);
+                release(index);
             }
         }
-
-        m_resources.clear();
+        std::fill(m_table.begin(), m_table.end(), empty_bucket);
     }
 
     /**
      * @brief Load instance in cache.
-     * @note If such id already exist in cache, resource will replace with an instance.
+     * @note If such id already exist in cache, resource will replace with an instance,
+     * handles of the id stay valid and resolve to the instance.
      * @param id Valid id type.
      * @param instance Valid resource.
      * @return Loaded in cache resource.
      */
     resource_type load(const id_type id, resource_type instance)
     {
-        if (has(id))
+        if (auto bucket = find(id); bucket != empty_bucket)
+        {
+            auto &slot = m_slots[m_table[bucket]];
+            if constexpr (Eraser)
+            {
+                if (slot.instance != instance)
+                {
+                    Eraser(slot.instance);
+                }
+            }
+            slot.instance = instance;
+            return instance;
+        }
+
+        if ((m_size + 1) * 2 > m_table.size())
+        {
+            rehash(m_table.empty() ? min_buckets : m_table.size() * 2);
+        }
+
+        std::uint32_t index;
+        if (m_free.empty())
+        {
+            index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+        else
+        {
+            index = m_free.back();
+            m_free.pop_back();
+        }
+        auto &slot = m_slots[index];
+        slot.instance = instance;
+        slot.id = id;
+        slot.used = true;
+        insert(index);
+        m_size++;
+        return instance;
+    }
+
+    /*! @copydoc load */
+    resource_type load(const std::string_view name, resource_type instance)
+    {
+        return load(hash(name), instance);
+    }
+
+    /**
+     * @brief Get handle of resource, keep it to skip lookups.
+     * @param id Valid id type.
+     * @return Handle, null one if such id not exist.
+     */
+    handle_type handle(const id_type id) const noexcept
+    {
+        auto bucket = find(id);
+        if (bucket == empty_bucket)
         {
-            erase(id);
+            return {};
         }
-        return m_resources.emplace(id, instance).first->second;
+        auto index = m_table[bucket];
+        return {index, m_slots[index].generation};
+    }
+
+    /*! @copydoc handle */
+    handle_type handle(const std::string_view name) const noexcept
+    {
+        return handle(hash(name));
     }
 
     /**
@@ -101,9 +205,35 @@ public:
      * @param id Valid id type.
      * @return Resource in success.
      */
-    resource_type resource(const id_type id)
+    resource_type resource(const id_type id) const
     {
-        return m_resources.at(id);
+        auto bucket = find(id);
+        if (bucket == empty_bucket)
+        {
+            throw std::out_of_range{"resource is not loaded"};
+        }
+        return m_slots[m_table[bucket]].instance;
+    }
+
+    /*! @copydoc resource */
+    resource_type resource(const std::string_view name) const
+    {
+        return resource(hash(name));
+    }
+
+    /**
+     * @brief Get resource by handle.
+     * @warning Throw exception if the handle is null or stale.
+     * @param handle Handle got from this cache.
+     * @return Resource in success.
+     */
+    resource_type resource(const handle_type handle) const
+    {
+        if (!has(handle))
+        {
+            throw std::out_of_range{"resource handle is stale"};
+        }
+        return m_slots[handle.index].instance;
     }
 
     /**
@@ -113,25 +243,150 @@ public:
      */
     bool has(const id_type id) const noexcept
     {
-        return (m_resources.find(id) != m_resources.end());
+        return find(id) != empty_bucket;
+    }
+
+    /*! @copydoc has */
+    bool has(const std::string_view name) const noexcept
+    {
+        return has(hash(name));
+    }
+
+    /**
+     * @brief Checks if a handle still refers to a loaded resource.
+     * @param handle Handle got from this cache.
+     * @return True if valid, otherwise false.
+     */
+    bool has(const handle_type handle) const noexcept
+    {
+        return handle.index < m_slots.size() && m_slots[handle.index].used &&
+               m_slots[handle.index].generation == handle.generation;
     }
 
     /**
-     * @brief Erase resource from cache.
+     * @brief Erase resource from cache, handles of it turn stale.
+     * @note Nothing happens if such id not exist.
      * @param id Valid id type.
      */
-    void erase(id_type id)
+    void erase(const id_type id)
     {
-        if constexpr (Eraser)
+        auto bucket = find(id);
+        if (bucket == empty_bucket)
         {
-            auto resource = m_resources.at(id);
-            Eraser(resource);
+            return;
         }
-        m_resources.erase(id);
+        release(m_table[bucket]);
+        remove(bucket);
+    }
+
+    /*! @copydoc erase */
+    void erase(const std::string_view name)
+    {
+        erase(hash(name));
     }
 
 private:
-    std::map<id_type, resource_type> m_resources;
+    struct slot
+    {
+        resource_type instance{};
+        id_type id{};
+        std::uint32_t generation = 0;
+        bool used = false;
+    };
+
+    static constexpr const std::uint32_t empty_bucket = ~std::uint32_t{0};
+    static constexpr const size_type min_buckets = 64;
+
+    size_type home(const id_type id) const noexcept
+    {
+        // Fibonacci hashing: high bits of the product depend on every bit of the id,
+        // so FNV ids which differ in a last character only still spread.
+        return static_cast<size_type>((static_cast<std::uint32_t>(id) * 2654435769u) >> m_shift);
+    }
+
+    size_type find(const id_type id) const noexcept
+    {
+        if (m_table.empty())
+        {
+            return empty_bucket;
+        }
+        auto mask = m_table.size() - 1;
+        for (auto bucket = home(id);; bucket = (bucket + 1) & mask)
+        {
+            auto index = m_table[bucket];
+            if (index == empty_bucket)
+            {
+                return empty_bucket;
+            }
+            if (m_slots[index].id == id)
+            {
+                return bucket;
+            }
+        }
+    }
+
+    void insert(const std::uint32_t index) noexcept
+    {
+        auto mask = m_table.size() - 1;
+        auto bucket = home(m_slots[index].id);
+        while (m_table[bucket] != empty_bucket)
+        {
+            bucket = (bucket + 1) & mask;
+        }
+        m_table[bucket] = index;
+    }
+
+    void remove(size_type bucket) noexcept
+    {
+        // Shift following entries back instead of leaving tombstones, probes stay short.
+        auto mask = m_table.size() - 1;
+        m_table[bucket] = empty_bucket;
+        for (auto next = (bucket + 1) & mask; m_table[next] != empty_bucket; next = (next + 1) & mask)
+        {
+            auto wanted = home(m_slots[m_table[next]].id);
+            if (((next - wanted) & mask) >= ((next - bucket) & mask))
+            {
+                m_table[bucket] = m_table[next];
+                m_table[next] = empty_bucket;
+                bucket = next;
+            }
+        }
+    }
+
+    void rehash(const size_type buckets)
+    {
+        m_table.assign(buckets, empty_bucket);
+        m_shift = 32;
+        for (auto size = buckets; size > 1; size >>= 1)
+        {
+            m_shift--;
+        }
+        for (std::uint32_t index = 0; index < m_slots.size(); index++)
+        {
+            if (m_slots[index].used)
+            {
+                insert(index);
+            }
+        }
+    }
+
+    void release(const std::uint32_t index)
+    {
+        auto &slot = m_slots[index];
+        if constexpr (Eraser)
+        {
+            Eraser(slot.instance);
+        }
+        slot = {resource_type{}, id_type{}, slot.generation + 1, false};
+        m_free.push_back(index);
+        m_size--;
+    }
+
+    std::vector<slot> m_slots;
+    std::vector<std::uint32_t> m_table;
+    std::vector<std::uint32_t> m_free;
+    size_type m_size = 0;
+    unsigned m_shift = 32;
 };
 } // namespace ssecs::resource
 
@@ -0,0 +1,447 @@
+#ifndef DECODE_HPP
+#define DECODE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace ssecs::resource
+{
+/*! @brief Byte buffer type. */
+using bytes_type = std::vector<std::uint8_t>;
+
+/**
+ * @brief Decode base64 text, whitespace is skipped.
+ * @param text Encoded text.
+ * @param out Decoded bytes are appended here.
+ * @return False if text is not valid base64.
+ */
+inline bool base64_decode(std::string_view text, bytes_type &out)
+{
+    auto value = [](const char c) -> int {
+        if (c >= 'A' && c <= 'Z')
+        {
+            return c - 'A';
+        }
+        if (c >= 'a' && c <= 'z')
+        {
+            return c - 'a' + 26;
+        }
+        if (c >= '0' && c <= '9')
+        {
+            return c - '0' + 52;
+        }
+        if (c == '+')
+        {
+            return 62;
+        }
+        if (c == '/')
+        {
+            return 63;
+        }
+        return -1;
+    };
+
+    out.reserve(out.size() + text.size() / 4 * 3);
+    std::uint32_t buffer = 0;
+    int bits = 0;
+    for (auto c : text)
+    {
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t')
+        {
+            continue;
+        }
+        if (c == '=')
+        {
+            break;
+        }
+        auto v = value(c);
+        if (v < 0)
+        {
+            return false;
+        }
+        buffer = (buffer << 6) | static_cast<std::uint32_t>(v);
+        bits += 6;
+        if (bits >= 8)
+        {
+            bits -= 8;
+            out.push_back(static_cast<std::uint8_t>(buffer >> bits));
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Minimal inflate (RFC 1951) decoder.
+ * Supports stored, fixed and dynamic blocks. Canonical codes are decoded bit by bit,
+ * which is plenty for tile layers decoded once at load.
+ */
+class inflater
+{
+public:
+    inflater(const std::uint8_t *data, const std::size_t size) : m_data{data}, m_size{size}
+    {
+    }
+
+    /**
+     * @brief Decompress the whole deflate stream.
+     * @param out Decompressed bytes are appended here.
+     * @return False on malformed stream.
+     */
+    bool inflate(bytes_type &out)
+    {
+        bool last = false;
+        while (!last)
+        {
+            last = bits(1);
+            auto type = bits(2);
+            bool result = false;
+            if (type == 0)
+            {
+                result = stored(out);
+            }
+            else if (type == 1)
+            {
+                result = fixed(out);
+            }
+            else if (type == 2)
+            {
+                result = dynamic(out);
+            }
+            if (!result || m_overrun)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*! @brief Returns count of consumed bytes. */
+    std::size_t consumed() const noexcept
+    {
+        return m_position;
+    }
+
+private:
+    static constexpr const int max_bits = 15;
+
+    struct huffman
+    {
+        std::array<std::uint16_t, max_bits + 1> counts{};
+        std::array<std::uint16_t, 288> symbols{};
+    };
+
+    int bits(const int need)
+    {
+        auto value = m_bitBuffer;
+        while (m_bitCount < need)
+        {
+            if (m_position >= m_size)
+            {
+                m_overrun = true;
+                return 0;
+            }
+            value |= static_cast<std::uint32_t>(m_data[m_position++]) << m_bitCount;
+            m_bitCount += 8;
+        }
+        m_bitBuffer = value >> need;
+        m_bitCount -= need;
+        return static_cast<int>(value & ((1u << need) - 1));
+    }
+
+    static bool build(huffman &h, const std::uint16_t *lengths, const int n)
+    {
+        h.counts.fill(0);
+        for (int symbol = 0; symbol < n; symbol++)
+        {
+            h.counts[lengths[symbol]]++;
+        }
+        if (h.counts[0] == n)
+        {
+            return true;
+        }
+
+        int left = 1;
+        for (int len = 1; len <= max_bits; len++)
+        {
+            left <<= 1;
+            left -= h.counts[len];
+            if (left < 0)
+            {
+                return false;
+            }
+        }
+
+        std::array<std::uint16_t, max_bits + 1> offsets{};
+        for (int len = 1; len < max_bits; len++)
+        {
+            offsets[len + 1] = offsets[len] + h.counts[len];
+        }
+        for (int symbol = 0; symbol < n; symbol++)
+        {
+            if (lengths[symbol])
+            {
+                h.symbols[offsets[lengths[symbol]]++] = static_cast<std::uint16_t>(symbol);
+            }
+        }
+        return true;
+    }
+
+    int decode(const huffman &h)
+    {
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (int len = 1; len <= max_bits; len++)
+        {
+            code |= bits(1);
+            int count = h.counts[len];
+            if (code - count < first)
+            {
+                return h.symbols[index + (code - first)];
+            }
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+        }
+        return -1;
+    }
+
+    bool stored(bytes_type &out)
+    {
+        m_bitBuffer = 0;
+        m_bitCount = 0;
+        if (m_position + 4 > m_size)
+        {
+            return false;
+        }
+        std::size_t len = m_data[m_position] | (m_data[m_position + 1] << 8);
+        std::size_t nlen = m_data[m_position + 2] | (m_data[m_position + 3] << 8);
+        m_position += 4;
+        if (len != (~nlen & 0xffff) || m_position + len > m_size)
+        {
+            return false;
+        }
+        out.insert(out.end(), m_data + m_position, m_data + m_position + len);
+        m_position += len;
+        return true;
+    }
+
+    bool codes(bytes_type &out, const huffman &lencode, const huffman &distcode)
+    {
+        static constexpr const std::uint16_t len_base[29]{3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                                          31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        static constexpr const std::uint16_t len_extra[29]{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                                           2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        static constexpr const std::uint16_t dist_base[30]{
+            1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+            193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+        static constexpr const std::uint16_t dist_extra[30]{0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                                            6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+        for (;;)
+        {
+            auto symbol = decode(lencode);
+            if (symbol < 0 || m_overrun)
+            {
+                return false;
+            }
+            if (symbol < 256)
+            {
+                out.push_back(static_cast<std::uint8_t>(symbol));
+            }
+            else if (symbol == 256)
+            {
+                return true;
+            }
+            else
+            {
+                symbol -= 257;
+                if (symbol >= 29)
+                {
+                    return false;
+                }
+                std::size_t len = len_base[symbol] + bits(len_extra[symbol]);
+
+                symbol = decode(distcode);
+                if (symbol < 0 || symbol >= 30)
+                {
+                    return false;
+                }
+                std::size_t dist = dist_base[symbol] + bits(dist_extra[symbol]);
+                if (dist > out.size() || m_overrun)
+                {
+                    return false;
+                }
+                auto from = out.size() - dist;
+                for (std::size_t i = 0; i < len; i++)
+                {
+                    out.push_back(out[from + i]);
+                }
+            }
+        }
+    }
+
+    bool fixed(bytes_type &out)
+    {
+        std::array<std::uint16_t, 288> lengths{};
+        for (int symbol = 0; symbol < 288; symbol++)
+        {
+            lengths[symbol] = symbol < 144 ? 8 : symbol < 256 ? 9 : symbol < 280 ? 7 : 8;
+        }
+        huffman lencode, distcode;
+        build(lencode, lengths.data(), 288);
+
+        lengths.fill(5);
+        build(distcode, lengths.data(), 30);
+        return codes(out, lencode, distcode);
+    }
+
+    bool dynamic(bytes_type &out)
+    {
+        static constexpr const std::uint8_t order[19]{16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+        auto nlen = bits(5) + 257;
+        auto ndist = bits(5) + 1;
+        auto ncode = bits(4) + 4;
+        if (nlen > 286 || ndist > 30)
+        {
+            return false;
+        }
+
+        std::array<std::uint16_t, 320> lengths{};
+        for (int index = 0; index < ncode; index++)
+        {
+            lengths[order[index]] = static_cast<std::uint16_t>(bits(3));
+        }
+        huffman lencode, distcode;
+        if (!build(lencode, lengths.data(), 19))
+        {
+            return false;
+        }
+
+        int index = 0;
+        while (index < nlen + ndist)
+        {
+            auto symbol = decode(lencode);
+            if (symbol < 0 || m_overrun)
+            {
+                return false;
+            }
+            if (symbol < 16)
+            {
+                lengths[index++] = static_cast<std::uint16_t>(symbol);
+                continue;
+            }
+
+            std::uint16_t len = 0;
+            int repeat = 0;
+            if (symbol == 16)
+            {
+                if (index == 0)
+                {
+                    return false;
+                }
+                len = lengths[index - 1];
+                repeat = 3 + bits(2);
+            }
+            else if (symbol == 17)
+            {
+                repeat = 3 + bits(3);
+            }
+            else
+            {
+                repeat = 11 + bits(7);
+            }
+            if (index + repeat > nlen + ndist)
+            {
+                return false;
+            }
+            while (repeat--)
+            {
+                lengths[index++] = len;
+            }
+        }
+        if (lengths[256] == 0)
+        {
+            return false;
+        }
+
+        if (!build(lencode, lengths.data(), nlen) || !build(distcode, lengths.data() + nlen, ndist))
+        {
+            return false;
+        }
+        return codes(out, lencode, distcode);
+    }
+
+    const std::uint8_t *m_data;
+    std::size_t m_size;
+    std::size_t m_position = 0;
+    std::uint32_t m_bitBuffer = 0;
+    int m_bitCount = 0;
+    bool m_overrun = false;
+};
+
+/**
+ * @brief Decompress zlib (RFC 1950) stream.
+ * @warning Preset dictionaries aren't supported and checksum isn't verified.
+ * @param data Compressed bytes.
+ * @param out Decompressed bytes are appended here.
+ * @return False on malformed stream.
+ */
+inline bool zlib_decompress(const bytes_type &data, bytes_type &out)
+{
+    if (data.size() < 2 || (data[0] & 0x0f) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 || (data[1] & 0x20))
+    {
+        return false;
+    }
+    inflater stream{data.data() + 2, data.size() - 2};
+    return stream.inflate(out);
+}
+
+/**
+ * @brief Decompress gzip (RFC 1952) stream.
+ * @warning Only the first member is read and checksum isn't verified.
+ * @param data Compressed bytes.
+ * @param out Decompressed bytes are appended here.
+ * @return False on malformed stream.
+ */
+inline bool gzip_decompress(const bytes_type &data, bytes_type &out)
+{
+    if (data.size() < 18 || data[0] != 0x1f || data[1] != 0x8b || data[2] != 8)
+    {
+        return false;
+    }
+    auto flags = data[3];
+    std::size_t position = 10;
+    if (flags & 0x04)
+    {
+        position += 2 + (data[position] | (data[position + 1] << 8));
+    }
+    for (auto flag : {0x08, 0x10})
+    {
+        if (flags & flag)
+        {
+            while (position < data.size() && data[position])
+            {
+                position++;
+            }
+            position++;
+        }
+    }
+    if (flags & 0x02)
+    {
+        position += 2;
+    }
+    if (position >= data.size())
+    {
+        return false;
+    }
+    inflater stream{data.data() + position, data.size() - position};
+    return stream.inflate(out);
+}
+} // namespace ssecs::resource
+
+#endif // DECODE_HPP
@@ -0,0 +1,117 @@
+#include "file_watcher.hpp"
+
+#include <algorithm>
+#include <system_error>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+bool ssecs::resource::file_watcher::watch(std::string_view path)
+{
+    std::filesystem::path file{path};
+    entry watched;
+    watched.path = path;
+    watched.name = file.filename().string();
+
+    std::error_code error;
+    watched.time = std::filesystem::last_write_time(file, error);
+    auto exists = !error;
+
+#ifdef __linux__
+    if (m_inotify < 0 && m_entries.empty())
+    {
+        m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    }
+    if (m_inotify >= 0)
+    {
+        auto directory = file.has_parent_path() ? file.parent_path().string() : std::string{"."};
+        // Saving may write in place or move a new file over, both end with one of these.
+        // Creation isn't watched, the file is still empty then.
+        watched.directory = inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    }
+#endif
+    // Files without a watched directory are polled.
+    m_entries.push_back(std::move(watched));
+    return exists;
+}
+
+void ssecs::resource::file_watcher::close() noexcept
+{
+#ifdef __linux__
+    if (m_inotify >= 0)
+    {
+        ::close(m_inotify);
+    }
+#endif
+    m_inotify = -1;
+    m_entries.clear();
+}
+
+bool ssecs::resource::file_watcher::native() const noexcept
+{
+    return m_inotify >= 0 &&
+           std::all_of(m_entries.begin(), m_entries.end(), [](const entry &watched) { return watched.directory >= 0; });
+}
+
+void ssecs::resource::file_watcher::poll(std::vector<std::string> &changed)
+{
+#ifdef __linux__
+    if (m_inotify >= 0)
+    {
+        alignas(inotify_event) char buffer[4096];
+        while (true)
+        {
+            auto size = read(m_inotify, buffer, sizeof(buffer));
+            if (size <= 0)
+            {
+                break;
+            }
+            for (auto position = buffer; position < buffer + size;)
+            {
+                auto event = reinterpret_cast<const inotify_event *>(position);
+                position += sizeof(inotify_event) + event->len;
+                for (auto &watched : m_entries)
+                {
+                    // Lost events may hide any change.
+                    if ((event->mask & IN_Q_OVERFLOW) ||
+                        (event->len && watched.directory == event->wd && watched.name == event->name))
+                    {
+                        report(changed, watched.path);
+                    }
+                }
+            }
+        }
+    }
+#endif
+
+    auto now = clock_type::now();
+    if (now < m_next)
+    {
+        return;
+    }
+    m_next = now + poll_interval;
+    for (auto &watched : m_entries)
+    {
+        if (watched.directory >= 0)
+        {
+            continue;
+        }
+        std::error_code error;
+        auto time = std::filesystem::last_write_time(watched.path, error);
+        if (!error && time != watched.time)
+        {
+            watched.time = time;
+            report(changed, watched.path);
+        }
+    }
+}
+
+void ssecs::resource::file_watcher::report(std::vector<std::string> &changed, const std::string &path)
+{
+    if (std::find(changed.begin(), changed.end(), path) == changed.end())
+    {
+        changed.push_back(path);
+    }
+}
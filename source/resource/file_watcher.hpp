@@ -0,0 +1,73 @@
+#ifndef FILE_WATCHER_HPP
+#define FILE_WATCHER_HPP
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ssecs::resource
+{
+/**
+ * @brief Watches files for changes.
+ * Uses inotify on Linux, elsewhere or if inotify fails modification times are polled every poll_interval.
+ * Directories of files are watched, so files that editors replace on save are caught too.
+ * poll never blocks, it's meant to be called once per frame.
+ */
+class file_watcher
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /*! @brief Time between checks of modification times without inotify. */
+    static constexpr const clock_type::duration poll_interval = std::chrono::milliseconds{500};
+
+    /*! @brief Default constructor. */
+    file_watcher() = default;
+    file_watcher(const file_watcher &) = delete;
+    file_watcher &operator=(const file_watcher &) = delete;
+
+    /*! @brief Invoke close. */
+    ~file_watcher()
+    {
+        close();
+    }
+
+    /**
+     * @brief Start watching the file.
+     * @param path Path to file, reported as given.
+     * @return False if the file doesn't exist yet, it's watched anyway and reported once it's written.
+     */
+    bool watch(std::string_view path);
+
+    /*! @brief Stop watching every file. */
+    void close() noexcept;
+
+    /*! @brief Returns true if changes come from inotify, false if they are polled. */
+    bool native() const noexcept;
+
+    /**
+     * @brief Collect files changed since the last call.
+     * @param changed Paths of changed files are appended, each once.
+     */
+    void poll(std::vector<std::string> &changed);
+
+private:
+    struct entry
+    {
+        std::string path;
+        std::string name;
+        int directory = -1;
+        std::filesystem::file_time_type time;
+    };
+
+    static void report(std::vector<std::string> &changed, const std::string &path);
+
+    std::vector<entry> m_entries;
+    clock_type::time_point m_next{};
+    int m_inotify = -1;
+};
+} // namespace ssecs::resource
+
+#endif // FILE_WATCHER_HPP
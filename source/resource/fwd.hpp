@@ -3,6 +3,9 @@
 
 namespace ssecs::resource
 {
+///*! @struct handle */
+struct handle;
+
 ///*! @class cache */
 template <typename t, void (*)(t)>
 class cache;
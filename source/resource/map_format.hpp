@@ -0,0 +1,186 @@
+#ifndef MAP_FORMAT_HPP
+#define MAP_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ssecs::resource
+{
+/**
+ * Layout of precompiled tile map (*.ssmap), little-endian, all offsets from the file start:
+ * @code
+ * map_header
+ * map_tileset[tileset_count]
+ * map_layer[layer_count]
+ * per layer: cells (width * height ids of id_size bytes, top row first), padded to 4 bytes,
+ *            solid bitmap (row_words * height 32-bit words, top row first)
+ * @endcode
+ * Cell and bitmap layout matches component::TileGrid, so loading is a plain copy.
+ * Size and hash of the source tmx are kept, so a map compiled from an older tmx is noticed.
+ */
+inline constexpr const char map_magic[4]{'S', 'S', 'M', 'P'};
+inline constexpr const std::uint32_t map_version = 2;
+/*! @brief Maps wider or higher are rejected, so sizes computed from the header can't overflow. */
+inline constexpr const std::uint32_t map_max_side = 1u << 16;
+/*! @brief Maps with more tile sets or layers are rejected. */
+inline constexpr const std::uint32_t map_max_count = 1u << 12;
+
+/*! @brief FNV-1a hash of the source tmx bytes. */
+inline std::uint64_t map_source_hash(const void *data, const std::size_t size) noexcept
+{
+    auto bytes = static_cast<const std::uint8_t *>(data);
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t index = 0; index < size; index++)
+    {
+        hash = (hash ^ bytes[index]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+/*! @brief Precompiled map header. */
+struct map_header
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t layer_count;
+    std::uint32_t tileset_count;
+    std::uint32_t id_size;
+    std::uint32_t row_words;
+    std::uint64_t source_size;
+    std::uint64_t source_hash;
+};
+
+/*! @brief Tile set referenced by the map. */
+struct map_tileset
+{
+    std::uint32_t first_gid;
+    char source[60];
+};
+
+/*! @brief Layer table entry. */
+struct map_layer
+{
+    std::uint32_t id;
+    std::uint32_t cells_offset;
+    std::uint32_t solid_offset;
+    std::uint32_t reserved;
+    char name[48];
+};
+
+/**
+ * @brief Read-only view over precompiled map bytes.
+ * Doesn't own the memory, usually it is a mapped_file.
+ */
+class map_view
+{
+public:
+    /**
+     * @brief Validate header and tables.
+     * @param data Map bytes.
+     * @param size Count of bytes.
+     * @return True if data is a valid map of current version.
+     */
+    bool open(const void *data, const std::size_t size) noexcept
+    {
+        m_data = static_cast<const std::uint8_t *>(data);
+        m_size = size;
+        if (!m_data || m_size < sizeof(map_header))
+        {
+            return false;
+        }
+        auto &head = header();
+        if (std::memcmp(head.magic, map_magic, sizeof(map_magic)) != 0 || head.version != map_version)
+        {
+            return false;
+        }
+        if (head.width > map_max_side || head.height > map_max_side || head.tileset_count > map_max_count ||
+            head.layer_count > map_max_count || head.row_words != (head.width + 31) / 32 ||
+            (head.id_size != 1 && head.id_size != 2 && head.id_size != 4))
+        {
+            return false;
+        }
+        // Limits above keep these products in 64 bits, offsets are checked against what is left,
+        // so nothing wraps even where size_t is 32-bit.
+        const std::uint64_t total = m_size;
+        auto tables = sizeof(map_header) + std::uint64_t{head.tileset_count} * sizeof(map_tileset) +
+                      std::uint64_t{head.layer_count} * sizeof(map_layer);
+        auto cells = std::uint64_t{head.width} * head.height * head.id_size;
+        auto solid = std::uint64_t{head.row_words} * head.height * sizeof(std::uint32_t);
+        if (tables > total || cells > total || solid > total)
+        {
+            return false;
+        }
+        for (std::uint32_t index = 0; index < head.layer_count; index++)
+        {
+            auto &entry = layers()[index];
+            if (entry.cells_offset > total - cells || entry.solid_offset > total - solid || entry.cells_offset % 4 ||
+                entry.solid_offset % 4)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*! @brief Returns true if the map was compiled from these source tmx bytes. */
+    bool built_from(const void *source, const std::size_t size) const noexcept
+    {
+        return header().source_size == size && header().source_hash == map_source_hash(source, size);
+    }
+
+    /*! @brief Returns map header. */
+    const map_header &header() const noexcept
+    {
+        return *reinterpret_cast<const map_header *>(m_data);
+    }
+
+    /*! @brief Returns pointer to first of header().tileset_count tile sets. */
+    const map_tileset *tilesets() const noexcept
+    {
+        return reinterpret_cast<const map_tileset *>(m_data + sizeof(map_header));
+    }
+
+    /*! @brief Returns pointer to first of header().layer_count layers. */
+    const map_layer *layers() const noexcept
+    {
+        return reinterpret_cast<const map_layer *>(tilesets() + header().tileset_count);
+    }
+
+    /**
+     * @brief Find layer by Tiled layer id.
+     * @return Layer if it exists, otherwise nullptr.
+     */
+    const map_layer *layer(const std::uint32_t id) const noexcept
+    {
+        for (std::uint32_t index = 0; index < header().layer_count; index++)
+        {
+            if (layers()[index].id == id)
+            {
+                return layers() + index;
+            }
+        }
+        return nullptr;
+    }
+
+    /*! @brief Returns cells of the layer. */
+    const void *cells(const map_layer &entry) const noexcept
+    {
+        return m_data + entry.cells_offset;
+    }
+
+    /*! @brief Returns solid bitmap of the layer. */
+    const std::uint32_t *solid(const map_layer &entry) const noexcept
+    {
+        return reinterpret_cast<const std::uint32_t *>(m_data + entry.solid_offset);
+    }
+
+private:
+    const std::uint8_t *m_data = nullptr;
+    std::size_t m_size = 0;
+};
+} // namespace ssecs::resource
+
+#endif // MAP_FORMAT_HPP
@@ -0,0 +1,61 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string_view>
+
+namespace ssecs::resource
+{
+/**
+ * @brief Read-only memory mapped file.
+ * Uses mmap on POSIX and file mapping objects on Windows.
+ */
+class mapped_file
+{
+public:
+    /*! @brief Default constructor. */
+    mapped_file() = default;
+    mapped_file(const mapped_file &) = delete;
+    mapped_file &operator=(const mapped_file &) = delete;
+
+    /*! @brief Invoke close. */
+    ~mapped_file()
+    {
+        close();
+    }
+
+    /**
+     * @brief Map the whole file.
+     * @param path Path to file.
+     * @return True in success, false if file can't be opened or mapped.
+     */
+    bool open(std::string_view path);
+
+    /*! @brief Unmap the file. */
+    void close() noexcept;
+
+    /*! @brief Returns mapped bytes or nullptr. */
+    const void *data() const noexcept
+    {
+        return m_data;
+    }
+
+    /*! @brief Returns count of mapped bytes. */
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+private:
+    const void *m_data = nullptr;
+    std::size_t m_size = 0;
+#ifdef _WIN32
+    void *m_file = nullptr;
+    void *m_mapping = nullptr;
+#else
+    int m_file = -1;
+#endif
+};
+} // namespace ssecs::resource
+
+#endif // MAPPED_FILE_HPP
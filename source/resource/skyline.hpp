@@ -0,0 +1,166 @@
+#ifndef SKYLINE_HPP
+#define SKYLINE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace ssecs::resource
+{
+/**
+ * @brief Rectangle packer for atlases.
+ * Rows go down like in textures. The skyline is the first free row under placed rectangles,
+ * kept as segments from left to right. Every rectangle goes where its bottom edge ends highest,
+ * ties go to the narrowest segment.
+ * Space under the skyline is never reused, which is fine for sheets and text added once.
+ */
+class skyline
+{
+public:
+    /*! @brief Top left corner of a placed rectangle. */
+    struct position
+    {
+        int x;
+        int y;
+    };
+
+    /*! @brief Default constructor, nothing fits until reset. */
+    skyline() = default;
+
+    /*! @brief Create empty packer of the size. */
+    skyline(const int width, const int height)
+    {
+        reset(width, height);
+    }
+
+    /*! @brief Forget placed rectangles and take the size. */
+    void reset(const int width, const int height)
+    {
+        m_width = width;
+        m_height = height;
+        m_used = 0;
+        m_segments.assign(1, {0, 0, width});
+    }
+
+    /*! @brief Returns width of packed area. */
+    int width() const noexcept
+    {
+        return m_width;
+    }
+
+    /*! @brief Returns height of packed area. */
+    int height() const noexcept
+    {
+        return m_height;
+    }
+
+    /*! @brief Returns area taken by placed rectangles. */
+    std::size_t used() const noexcept
+    {
+        return m_used;
+    }
+
+    /**
+     * @brief Place rectangle.
+     * @param width Width of rectangle.
+     * @param height Height of rectangle.
+     * @param where Filled with top left corner in success.
+     * @return False if there is no room.
+     */
+    bool insert(const int width, const int height, position &where)
+    {
+        if (width <= 0 || height <= 0)
+        {
+            return false;
+        }
+        auto best = m_segments.size();
+        auto bestBottom = std::numeric_limits<int>::max();
+        auto bestWidth = std::numeric_limits<int>::max();
+        for (std::size_t index = 0; index < m_segments.size(); index++)
+        {
+            int level;
+            if (fit(index, width, height, level) &&
+                (level + height < bestBottom || (level + height == bestBottom && m_segments[index].width < bestWidth)))
+            {
+                best = index;
+                bestBottom = level + height;
+                bestWidth = m_segments[index].width;
+            }
+        }
+        if (best == m_segments.size())
+        {
+            return false;
+        }
+
+        where = {m_segments[best].x, bestBottom - height};
+        raise(best, width, bestBottom);
+        m_used += static_cast<std::size_t>(width) * height;
+        return true;
+    }
+
+private:
+    struct segment
+    {
+        int x;
+        int y;
+        int width;
+    };
+
+    /*! @brief Returns false if rectangle starting at the segment leaves the area, level is its top row. */
+    bool fit(std::size_t index, const int width, const int height, int &level) const noexcept
+    {
+        if (m_segments[index].x + width > m_width)
+        {
+            return false;
+        }
+        level = 0;
+        for (auto left = width; left > 0; index++)
+        {
+            level = std::max(level, m_segments[index].y);
+            left -= m_segments[index].width;
+        }
+        return level + height <= m_height;
+    }
+
+    /*! @brief Put segment under the placed rectangle and cut ones it covers. */
+    void raise(const std::size_t index, const int width, const int bottom)
+    {
+        segment placed{m_segments[index].x, bottom, width};
+        auto right = placed.x + width;
+        auto last = index;
+        while (last < m_segments.size() && m_segments[last].x + m_segments[last].width <= right)
+        {
+            last++;
+        }
+        if (last < m_segments.size() && m_segments[last].x < right)
+        {
+            m_segments[last].width -= right - m_segments[last].x;
+            m_segments[last].x = right;
+        }
+        m_segments.erase(m_segments.begin() + index, m_segments.begin() + last);
+        m_segments.insert(m_segments.begin() + index, placed);
+
+        // Neighbours of the same height are one segment.
+        for (std::size_t merged = 0; merged + 1 < m_segments.size();)
+        {
+            if (m_segments[merged].y == m_segments[merged + 1].y)
+            {
+                m_segments[merged].width += m_segments[merged + 1].width;
+                m_segments.erase(m_segments.begin() + merged + 1);
+            }
+            else
+            {
+                merged++;
+            }
+        }
+    }
+
+    std::vector<segment> m_segments;
+    int m_width = 0;
+    int m_height = 0;
+    std::size_t m_used = 0;
+};
+} // namespace ssecs::resource
+
+#endif // SKYLINE_HPP
@@ -0,0 +1,267 @@
+#ifndef ASSET_LOADER_HPP
+#define ASSET_LOADER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <SDL_surface.h>
+#include <SDL_ttf.h>
+
+#include "../resource/cache.hpp"
+#include "atlas.hpp"
+#include "glyph_cache.hpp"
+#include "resource_loader.hpp"
+#include "timer.hpp"
+
+namespace ssecs::sdl
+{
+/**
+ * @brief The AssetLoader class.
+ * Loads assets on a background thread while frames go on.
+ * Jobs run one by one in order they are queued: decoding, parsing, opening fonts and music.
+ * Only uploads need the renderer, jobs post them to a bounded queue that the main thread drains
+ * with Upload in a time budget every frame. When the queue is full the loader waits,
+ * so decoded surfaces never pile up.
+ * One thread is enough for a few assets, it also keeps SDL_ttf calls serialized:
+ * after Start rasterize glyphs with Glyphs, not on the main thread.
+ * @warning Never block on futures of the loader on the main thread, its job may wait for Upload. Poll with Ready.
+ */
+class AssetLoader
+{
+public:
+    using task_type = std::function<void()>;
+    using id_type = Atlas::id_type;
+
+    /*! @brief Uploads waiting for the main thread before the loader blocks. */
+    static constexpr const std::size_t upload_capacity = 16;
+
+    AssetLoader() = default;
+    AssetLoader(const AssetLoader &) = delete;
+    AssetLoader &operator=(const AssetLoader &) = delete;
+
+    /*! @brief Invoke Stop. */
+    ~AssetLoader()
+    {
+        Stop();
+    }
+
+    /*! @brief Start the loader thread if it isn't running. */
+    void Start()
+    {
+        if (m_thread.joinable())
+        {
+            return;
+        }
+        m_stop = false;
+        m_thread = std::thread{[this] { Work(); }};
+    }
+
+    /*! @brief Drop queued jobs and uploads, finish the running job and join the thread. */
+    void Stop()
+    {
+        {
+            std::lock_guard lock{m_mutex};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        m_space.notify_all();
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+        std::lock_guard lock{m_mutex};
+        m_jobs.clear();
+        m_uploads.clear();
+    }
+
+    /*! @brief Returns true if there are no jobs and no uploads left. */
+    bool Idle() const
+    {
+        std::lock_guard lock{m_mutex};
+        return m_jobs.empty() && m_uploads.empty() && !m_busy;
+    }
+
+    /*! @brief Returns true if the future has its value, never blocks. */
+    template <typename Type>
+    static bool Ready(const std::shared_future<Type> &future)
+    {
+        return future.valid() && future.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+    }
+
+    /**
+     * @brief Run func on the loader thread.
+     * @param func Callable without arguments, must not touch the renderer.
+     * @return Future of func result, it also holds thrown exception.
+     */
+    template <typename Func>
+    auto Async(Func &&func)
+    {
+        using result_type = std::invoke_result_t<std::decay_t<Func>>;
+        auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<Func>(func));
+        std::shared_future<result_type> future = task->get_future();
+        Queue([task] { (*task)(); });
+        return future;
+    }
+
+    /**
+     * @brief Decode image on the loader thread and pack it into the atlas later.
+     * @param atlas Atlas to pack the image in.
+     * @param id Id of the region.
+     * @param path Path to image file.
+     * @return Handle of the region, valid right away, its rect is empty until the upload.
+     */
+    resource::handle Texture(Atlas &atlas, const id_type id, std::string path)
+    {
+        Queue([this, &atlas, id, path = std::move(path)] {
+            PostRegion(atlas, id, Atlas::Convert(ResourceLoader::Image(path)));
+        });
+        return atlas.Reserve(id);
+    }
+
+    /**
+     * @brief Rasterize every glyph of the cache on the loader thread and pack them into the atlas later.
+     * Glyphs are drawn white, labels tint nothing.
+     * @param atlas Atlas to pack glyphs in.
+     * @param glyphs Cache to fill, assigned to the atlas under the font id right away.
+     * @param font Font that only the loader uses.
+     * @param id Id of the font.
+     */
+    void Glyphs(Atlas &atlas, GlyphCache &glyphs, TTF_Font *font, const id_type id)
+    {
+        glyphs.Assign(atlas, id);
+        Queue([this, &atlas, &glyphs, font, id] {
+            auto height = TTF_FontHeight(font);
+            for (auto character = GlyphCache::first; character <= GlyphCache::last; character++)
+            {
+                int advance = 0;
+                TTF_GlyphMetrics(font, character, nullptr, nullptr, nullptr, nullptr, &advance);
+                // Characters the font lacks keep an empty region, they only move the pen.
+                SDL_Surface *surface = nullptr;
+                if (TTF_GlyphIsProvided(font, character))
+                {
+                    surface = Atlas::Convert(ResourceLoader::GlyphSurface(font, character, {255, 255, 255, 255}));
+                }
+                std::shared_ptr<SDL_Surface> owner{surface, SDL_FreeSurface};
+                Post([&atlas, &glyphs, id, character, advance, height, owner] {
+                    if (owner)
+                    {
+                        atlas.Insert(GlyphCache::Id(id, character), owner.get());
+                    }
+                    glyphs.Set(character, advance, height);
+                });
+            }
+        });
+    }
+
+    /**
+     * @brief Queue task to the main thread, waits while the upload queue is full.
+     * @param task Task invoked by Upload, dropped if the loader stops.
+     */
+    void Post(task_type task)
+    {
+        std::unique_lock lock{m_mutex};
+        m_space.wait(lock, [this] { return m_stop || m_uploads.size() < upload_capacity; });
+        if (!m_stop)
+        {
+            m_uploads.push_back(std::move(task));
+        }
+    }
+
+    /**
+     * @brief Run posted tasks on the main thread until the budget is spent, one at least.
+     * Errors of loader jobs are thrown from here.
+     * @param budget Milliseconds uploads may take this frame.
+     * @return Count of tasks done.
+     */
+    std::size_t Upload(const double budget)
+    {
+        std::size_t done = 0;
+        Timer timer;
+        timer.Record();
+        do
+        {
+            task_type task;
+            {
+                std::lock_guard lock{m_mutex};
+                if (m_uploads.empty())
+                {
+                    break;
+                }
+                task = std::move(m_uploads.front());
+                m_uploads.pop_front();
+            }
+            m_space.notify_one();
+            task();
+            done++;
+        } while (timer.Ellapsed() * 1000.0 < budget);
+        return done;
+    }
+
+private:
+    void Queue(task_type job)
+    {
+        {
+            std::lock_guard lock{m_mutex};
+            m_jobs.push_back(std::move(job));
+        }
+        m_wake.notify_one();
+    }
+
+    void PostRegion(Atlas &atlas, const id_type id, SDL_Surface *surface)
+    {
+        std::shared_ptr<SDL_Surface> owner{surface, SDL_FreeSurface};
+        Post([&atlas, id, owner] { atlas.Insert(id, owner.get()); });
+    }
+
+    void Work()
+    {
+        while (true)
+        {
+            task_type job;
+            {
+                std::unique_lock lock{m_mutex};
+                m_wake.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+                if (m_stop)
+                {
+                    return;
+                }
+                job = std::move(m_jobs.front());
+                m_jobs.pop_front();
+                m_busy = true;
+            }
+            try
+            {
+                job();
+            }
+            catch (...)
+            {
+                Post([error = std::current_exception()] { std::rethrow_exception(error); });
+            }
+            std::lock_guard lock{m_mutex};
+            m_busy = false;
+        }
+    }
+
+    std::thread m_thread;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_space;
+    std::deque<task_type> m_jobs;
+    std::deque<task_type> m_uploads;
+    bool m_busy = false;
+    bool m_stop = false;
+};
+} // namespace ssecs::sdl
+
+#endif // ASSET_LOADER_HPP
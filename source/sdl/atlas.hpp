@@ -0,0 +1,196 @@
+#ifndef ATLAS_HPP
+#define ATLAS_HPP
+
+#include <string_view>
+
+#include <SDL_render.h>
+#include <SDL_surface.h>
+
+#include "../resource/cache.hpp"
+#include "../resource/skyline.hpp"
+#include "config.hpp"
+#include "graphics.hpp"
+
+namespace ssecs::sdl
+{
+/**
+ * @brief The Atlas class.
+ * One static texture that sprite sheets and text glyphs are packed into,
+ * so sprites and labels of a layer are drawn from one texture in one batch.
+ * Every image is a region found by id, components keep handles of regions.
+ * Adding an id again reuses its space when the new image fits, so text can be changed in place.
+ * @note Surfaces must be in pixel_format, convert them off the main thread with Convert.
+ */
+class Atlas
+{
+public:
+    using id_type = entt::hashed_string::hash_type;
+
+    /*! @brief Pixel format of the atlas, TTF blended glyphs come in it. */
+    static constexpr const Uint32 pixel_format = SDL_PIXELFORMAT_ARGB8888;
+    /*! @brief Empty pixels between regions, so filtering doesn't bleed. */
+    static constexpr const int padding = 1;
+    /*! @brief Widths are rounded up to it, so changed text mostly fits its old space. */
+    static constexpr const int width_step = 16;
+
+    /*! @brief Place of an image. */
+    struct Region
+    {
+        SDL_Rect rect{};  /*!< Pixels of the image, empty until it's added. */
+        SDL_Rect space{}; /*!< Space taken in the atlas. */
+    };
+
+    Atlas() = default;
+    Atlas(const Atlas &) = delete;
+    Atlas &operator=(const Atlas &) = delete;
+
+    /*! @brief Invoke Reset. */
+    ~Atlas()
+    {
+        Reset();
+    }
+
+    /*! @brief Create empty atlas texture of the size, the renderer must exist. */
+    void Create(const int width, const int height)
+    {
+        Reset();
+        m_texture = SDL_CreateTexture(Graphics::Renderer(), pixel_format, SDL_TEXTUREACCESS_STATIC, width, height);
+        if (!m_texture)
+        {
+            SDL_THROW();
+        }
+        SDL_SetTextureBlendMode(m_texture, SDL_BLENDMODE_BLEND);
+        m_packer.reset(width, height);
+    }
+
+    /*! @brief Destroy texture and forget regions, their handles turn stale. */
+    void Reset()
+    {
+        if (m_texture)
+        {
+            SDL_DestroyTexture(m_texture);
+            m_texture = nullptr;
+        }
+        m_regions.reset();
+        m_packer.reset(0, 0);
+    }
+
+    /*! @brief Hash name the way "name"_hs does, for ids built at runtime. */
+    static id_type Hash(const std::string_view name) noexcept
+    {
+        return entt::hashed_string::value(name.data(), name.size());
+    }
+
+    /*! @brief Returns the atlas texture. */
+    SDL_Texture *Texture() const noexcept
+    {
+        return m_texture;
+    }
+
+    /*! @brief Returns share of the atlas taken, from 0 to 1. */
+    float Usage() const noexcept
+    {
+        auto area = static_cast<float>(m_packer.width()) * m_packer.height();
+        return area > 0 ? m_packer.used() / area : 0.f;
+    }
+
+    /**
+     * @brief Convert surface to pixel_format, doesn't need the renderer.
+     * @param surface Surface to convert, it's freed unless it's returned.
+     * @return Surface in pixel_format.
+     */
+    static SDL_Surface *Convert(SDL_Surface *surface)
+    {
+        if (surface->format->format == pixel_format)
+        {
+            return surface;
+        }
+        auto converted = SDL_ConvertSurfaceFormat(surface, pixel_format, 0);
+        SDL_FreeSurface(surface);
+        if (!converted)
+        {
+            SDL_THROW();
+        }
+        return converted;
+    }
+
+    /**
+     * @brief Get handle of the id, adding empty region if there is none.
+     * @param id Id of the image.
+     * @return Handle valid right away.
+     */
+    resource::handle Reserve(const id_type id)
+    {
+        if (!m_regions.has(id))
+        {
+            m_regions.load(id, Region{});
+        }
+        return m_regions.handle(id);
+    }
+
+    /**
+     * @brief Copy surface pixels into the atlas.
+     * @warning Throw exception if there is no room.
+     * @param id Id of the image, its old pixels are replaced.
+     * @param surface Surface in pixel_format, stays owned by caller.
+     * @return Handle of the region.
+     */
+    resource::handle Insert(const id_type id, SDL_Surface *surface)
+    {
+        SSECS_ASSERT(m_texture && surface->format->format == pixel_format);
+        auto region = m_regions.has(id) ? m_regions.resource(id) : Region{};
+        if (surface->w > region.space.w || surface->h > region.space.h)
+        {
+            auto width = (surface->w + width_step - 1) / width_step * width_step;
+            resource::skyline::position where;
+            if (!m_packer.insert(width + padding, surface->h + padding, where))
+            {
+                FAST_THROW("Atlas is full.");
+            }
+            region.space = {where.x, where.y, width, surface->h};
+        }
+        region.rect = {region.space.x, region.space.y, surface->w, surface->h};
+
+        if (SDL_MUSTLOCK(surface) && SDL_LockSurface(surface))
+        {
+            SDL_THROW();
+        }
+        auto result = SDL_UpdateTexture(m_texture, &region.rect, surface->pixels, surface->pitch);
+        if (SDL_MUSTLOCK(surface))
+        {
+            SDL_UnlockSurface(surface);
+        }
+        if (result)
+        {
+            SDL_THROW();
+        }
+        m_regions.load(id, region);
+        return m_regions.handle(id);
+    }
+
+    /*! @brief Returns true if the image of the id is in the atlas. */
+    bool Has(const id_type id) const noexcept
+    {
+        return m_regions.has(id) && m_regions.resource(id).rect.w > 0;
+    }
+
+    /*! @brief Returns pixels of the image, empty rect if it isn't added yet or the handle is stale. */
+    SDL_Rect Rect(const resource::handle handle) const noexcept
+    {
+        return m_regions.has(handle) ? m_regions.resource(handle).rect : SDL_Rect{};
+    }
+
+    /*! @brief Returns pixels of the image, empty rect if it isn't added yet. */
+    SDL_Rect Rect(const id_type id) const noexcept
+    {
+        return m_regions.has(id) ? m_regions.resource(id).rect : SDL_Rect{};
+    }
+
+private:
+    SDL_Texture *m_texture = nullptr;
+    resource::skyline m_packer;
+    resource::cache<Region> m_regions;
+};
+} // namespace ssecs::sdl
+
+#endif // ATLAS_HPP
@@ -21,6 +21,41 @@
 #define SDL_RENDER_LAYERS 10
 #endif
 
+#ifndef SSECS_TILE_ID_TYPE
+#include <cstdint>
+#define SSECS_TILE_ID_TYPE std::uint16_t
+#endif
+
+#ifndef SSECS_TILE_CHUNK_SIZE
+#define SSECS_TILE_CHUNK_SIZE 16
+#endif
+
+#ifndef SSECS_WORKER_COUNT
+#include <algorithm>
+#include <thread>
+// Worker threads besides the main one, define as 0 to run everything on the main thread.
+#define SSECS_WORKER_COUNT (std::max(std::thread::hardware_concurrency(), 1u) - 1)
+#endif
+
+// SIMD kernels of batch math, define SSECS_DISABLE_SIMD to use plain loops.
+#ifndef SSECS_DISABLE_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SSECS_SIMD_SSE
+// AVX2 kernels are compiled next to SSE ones and picked at runtime if the CPU has it.
+#if defined(__GNUC__) || defined(__clang__)
+#define SSECS_SIMD_AVX2
+#define SSECS_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER)
+#define SSECS_SIMD_AVX2
+#define SSECS_TARGET_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define SSECS_SIMD_NEON
+#endif
+#endif
+
+// Assets are watched and reloaded while the game runs, define SSECS_DISABLE_HOT_RELOAD to leave them alone.
+
 #ifndef SSECS_DISABLE_ASSERT
 #include <cassert>
 #define SSECS_ASSERT(condition) assert(condition)
@@ -1,28 +1,92 @@
 #ifndef EVENT_HANDLER_HPP
 #define EVENT_HANDLER_HPP
 
+#include <vector>
+
 #include <SDL_events.h>
 
+#include "../../entt/signal/dispatcher.hpp"
 #include "fwd.hpp"
+#include "profiler.hpp"
 
 namespace ssecs::sdl
 {
+/*! @brief Published for every key press, including auto repeat. */
+struct KeyDown
+{
+    SDL_Keysym keysym;
+    bool repeat;
+};
+
+/*! @brief Published for every key release. */
+struct KeyUp
+{
+    SDL_Keysym keysym;
+};
+
+/**
+ * @brief The Events class.
+ * Each frame Game drains the whole SDL queue into a buffer and publishes it through the dispatcher:
+ * key events as KeyDown and KeyUp, and every event as SDL_Event.
+ * Connect listeners with Dispatcher().sink<Event>().connect<&Listener>().
+ */
 class Events
 {
     friend Game;
 
 public:
-    static const SDL_Event &Event() noexcept
+    /*! @brief Returns events polled this frame. */
+    static const std::vector<SDL_Event> &Queue() noexcept
     {
-        return m_event;
+        return m_events;
     }
     static const Uint8 *KeyboardState() noexcept
     {
         return SDL_GetKeyboardState(NULL);
     }
+    /*! @brief Returns dispatcher which publishes polled events. */
+    static entt::dispatcher &Dispatcher() noexcept
+    {
+        return m_dispatcher;
+    }
 
 private:
-    static inline SDL_Event m_event{};
+    /*! @brief Move all pending events to the buffer, keeping its capacity. */
+    static void Poll()
+    {
+        SSECS_PROFILE("Events::Poll");
+        m_events.clear();
+        SDL_Event event;
+        while (SDL_PollEvent(&event))
+        {
+            m_events.push_back(event);
+        }
+    }
+
+    /*! @brief Notify listeners about buffered events in order they came. */
+    static void Publish()
+    {
+        SSECS_PROFILE("Events::Publish");
+        for (const auto &event : m_events)
+        {
+            if (event.type == SDL_KEYDOWN)
+            {
+                m_dispatcher.trigger(KeyDown{event.key.keysym, event.key.repeat != 0});
+            }
+            else if (event.type == SDL_KEYUP)
+            {
+                m_dispatcher.trigger(KeyUp{event.key.keysym});
+            }
+            m_dispatcher.trigger(event);
+        }
+    }
+
+    static inline std::vector<SDL_Event> m_events = [] {
+        std::vector<SDL_Event> events;
+        events.reserve(256);
+        return events;
+    }();
+    static inline entt::dispatcher m_dispatcher{};
 };
 } // namespace ssecs::sdl
 
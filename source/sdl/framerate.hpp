@@ -1,30 +1,155 @@
 #ifndef FRAMERATE_HPP
 #define FRAMERATE_HPP
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 #include "fwd.hpp"
 #include "timer.hpp"
 
 namespace ssecs::sdl
 {
+/*! @brief Frame time over last FrameRate::history frames, in milliseconds. */
+struct FrameStatistics
+{
+    float min = 0;
+    float average = 0;
+    float p99 = 0;
+};
+
+/**
+ * @brief The FrameRate class.
+ * Measures real frame time and accumulates it for fixed simulation steps.
+ * Each frame Game runs FixedUpdate while Step returns true, at most m_maxFixedSteps times,
+ * the rest of accumulated time is passed to Render as Alpha.
+ * If frame lock is on, OnFrameEnd waits until the frame took 1 / target frame rate.
+ */
 class FrameRate
 {
     friend Game;
 
 public:
+    static constexpr const std::size_t history = 120;
+
     void OnFrameStart()
     {
-        m_deltaTime = static_cast<float>(m_timer.Ellapsed() / 1000.f);
+        m_deltaTime = static_cast<float>(m_timer.Ellapsed());
         m_timer.Record();
 
-        dt = m_hasFrameLock ? (1.0f / m_targetFrameRate) : m_deltaTime;
+        m_frameTimes[m_head] = m_deltaTime * 1000.f;
+        m_head = (m_head + 1) % history;
+        m_filled = std::min(m_filled + 1, history);
+
+        // Application probably lost control (debugger, window drag), don't try to catch up.
+        dt = std::min(m_deltaTime, m_maxDeltaTime);
+        m_deltaTimeAccumulator += dt;
+        m_fixedSteps = 0;
+    }
+
+    /**
+     * @brief Wait for the rest of the frame if frame lock is on.
+     * Sleeps while there is more than m_spinTime left, because SDL_Delay may oversleep,
+     * then spins on the counter.
+     */
+    void OnFrameEnd()
+    {
+        if (!m_hasFrameLock)
+        {
+            return;
+        }
+        const double frameTime = 1.0 / m_targetFrameRate;
+        auto remaining = frameTime - m_timer.Ellapsed();
+        if (remaining > m_spinTime)
+        {
+            SDL_Delay(static_cast<Uint32>((remaining - m_spinTime) * 1000));
+        }
+        while (m_timer.Ellapsed() < frameTime)
+        {
+        }
+    }
+
+    /**
+     * @brief Consume one fixed step from accumulated time.
+     * @return True if FixedUpdate should run once more this frame.
+     * @note If step cap is reached, leftover whole steps are dropped so simulation
+     * slows down instead of falling further behind.
+     */
+    bool Step() noexcept
+    {
+        if (m_deltaTimeAccumulator < fixedDt)
+        {
+            return false;
+        }
+        if (m_fixedSteps == m_maxFixedSteps)
+        {
+            m_deltaTimeAccumulator = std::fmod(m_deltaTimeAccumulator, fixedDt);
+            return false;
+        }
+        m_deltaTimeAccumulator -= fixedDt;
+        m_fixedSteps++;
+        return true;
+    }
+
+    /*! @brief Returns part of fixed step which is accumulated but not simulated yet, [0, 1). */
+    float Alpha() const noexcept
+    {
+        return m_deltaTimeAccumulator / fixedDt;
+    }
+
+    /**
+     * @brief Limit frame rate.
+     * @param targetFrameRate Frames per second, must be positive.
+     */
+    void Lock(const float targetFrameRate) noexcept
+    {
+        m_targetFrameRate = targetFrameRate;
+        m_hasFrameLock = true;
+    }
+
+    /*! @brief Run frames as fast as possible. */
+    void Unlock() noexcept
+    {
+        m_hasFrameLock = false;
+    }
+
+    /*! @brief Returns min, average and 99th percentile of recorded frame times. */
+    FrameStatistics Statistics() const
+    {
+        FrameStatistics statistics;
+        if (!m_filled)
+        {
+            return statistics;
+        }
+        std::array<float, history> sorted;
+        auto end = std::copy_n(m_frameTimes.begin(), m_filled, sorted.begin());
+        auto p99 = sorted.begin() + (m_filled - 1) * 99 / 100;
+        std::nth_element(sorted.begin(), p99, end);
+
+        statistics.p99 = *p99;
+        statistics.min = *std::min_element(sorted.begin(), end);
+        float sum = 0;
+        std::for_each(sorted.begin(), end, [&sum](const float time) { sum += time; });
+        statistics.average = sum / m_filled;
+        return statistics;
     }
 
 private:
-    float dt;
+    float dt = 0;
+    float fixedDt = 1.0f / 60;
 
     float m_targetFrameRate = 60;
     bool m_hasFrameLock = true;
     float m_deltaTime = 0;
+    float m_deltaTimeAccumulator = 0;
+    float m_maxDeltaTime = 0.25f;
+    int m_maxFixedSteps = 5;
+    int m_fixedSteps = 0;
+    double m_spinTime = 0.002;
+
+    std::array<float, history> m_frameTimes{};
+    std::size_t m_head = 0;
+    std::size_t m_filled = 0;
 
     Timer m_timer;
 };
@@ -13,6 +13,7 @@
 
 #include "events.hpp"
 #include "graphics.hpp"
+#include "profiler.hpp"
 
 namespace ssecs::sdl
 {
@@ -31,36 +32,42 @@ private:
 
     void InputUpdate()
     {
-        SDL_PollEvent(&Events::m_event);
+        Events::Poll();
 
-        // Check for terminate.
-        if (Events::Event().type == SDL_QUIT)
+        for (const auto &event : Events::Queue())
         {
-            Quit();
-        }
-        if (Events::Event().window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
-        {
-            Graphics::DestroyLayers();
-            Graphics::CreateLayers();
+            // Check for terminate.
+            if (event.type == SDL_QUIT)
+            {
+                Quit();
+            }
+            if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+            {
+                Graphics::DestroyLayers();
+                Graphics::CreateLayers();
+            }
         }
 
+        Events::Publish();
+
         m_scene->InputUpdate();
     }
     void Update(const float dt)
     {
         m_scene->Update(dt);
     }
-    void FixedUpdate()
+    void FixedUpdate(const float dt)
     {
-        m_scene->FixedUpdate();
+        m_scene->FixedUpdate(dt);
     }
 
-    void Render()
+    void Render(const float alpha)
     {
         Graphics::OnRenderStart();
 
-        m_scene->Render();
+        m_scene->Render(alpha);
 
+        Graphics::Flush();
         Graphics::DrawLayers();
         Graphics::RenderPresent();
     }
@@ -127,16 +134,27 @@ public:
         while (m_isRunning)
         {
 
+#ifndef SSECS_DISABLE_PROFILER
+            Profiler::BeginFrame();
+#endif
             m_frameRate.OnFrameStart();
 
-            FixedUpdate();
+            // Fixed-timed update, zero or more times per frame:
+            while (m_frameRate.Step())
+            {
+                FixedUpdate(m_frameRate.fixedDt);
+            }
 
             // Variable-timed update:
             Update(m_frameRate.dt);
 
             InputUpdate();
 
-            Render();
+            Render(m_frameRate.Alpha());
+#ifndef SSECS_DISABLE_PROFILER
+            Profiler::EndFrame();
+#endif
+            m_frameRate.OnFrameEnd();
         }
     }
     /*! @brief Request to quit from the game loop */
@@ -151,6 +169,12 @@ public:
         return m_isRunning;
     }
 
+    /*! @brief Return frame timing, use it to lock frame rate or read frame statistics. */
+    FrameRate &GetFrameRate() noexcept
+    {
+        return m_frameRate;
+    }
+
     /**
      * @brief Return current scene.
      */
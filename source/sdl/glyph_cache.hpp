@@ -0,0 +1,138 @@
+#ifndef GLYPH_CACHE_HPP
+#define GLYPH_CACHE_HPP
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <SDL_rect.h>
+
+#include "../resource/cache.hpp"
+#include "atlas.hpp"
+
+namespace ssecs::sdl
+{
+/**
+ * @brief The GlyphCache class.
+ * Glyphs of one font at one size, each rasterized once into the atlas.
+ * Text is laid out from glyph advances and drawn as one quad per glyph from the atlas texture,
+ * so changing text costs no rendering, no texture and no atlas space.
+ * Printable ASCII only, other characters are drawn as fallback.
+ * Glyph cells are TTF renders of one character, all of font height with the baseline at the same row,
+ * so glyphs of a line share the top edge.
+ * @note Not thread safe, lay out text on the main thread. AssetLoader::Glyphs fills the cache.
+ */
+class GlyphCache
+{
+public:
+    using id_type = Atlas::id_type;
+
+    /*! @brief First character of the cache. */
+    static constexpr const char first = ' ';
+    /*! @brief Last character of the cache. */
+    static constexpr const char last = '~';
+    /*! @brief Character drawn for ones out of the cache. */
+    static constexpr const char fallback = '?';
+    /*! @brief Count of cached glyphs. */
+    static constexpr const std::size_t count = last - first + 1;
+
+    /*! @brief Glyph of a character. */
+    struct Glyph
+    {
+        resource::handle region; /*!< Region of the atlas, its rect is empty until uploaded. */
+        int advance = 0;         /*!< Pixels to the next glyph. */
+    };
+
+    /**
+     * @brief Reserve atlas regions of every glyph, forget metrics.
+     * @param atlas Atlas glyphs are packed in, must outlive the cache.
+     * @param font Id of the font, keeps regions of fonts apart.
+     */
+    void Assign(Atlas &atlas, const id_type font)
+    {
+        m_atlas = &atlas;
+        m_height = 0;
+        for (std::size_t index = 0; index < count; index++)
+        {
+            m_glyphs[index] = {atlas.Reserve(Id(font, static_cast<char>(first + index))), 0};
+        }
+    }
+
+    /*! @brief Returns id of the atlas region of the glyph. */
+    static id_type Id(const id_type font, const char character)
+    {
+        return Atlas::Hash("glyph_" + std::to_string(font) + '_' + character);
+    }
+
+    /*! @brief Set metrics of a cached character and height of the font. */
+    void Set(const char character, const int advance, const int height) noexcept
+    {
+        m_glyphs[Index(character)].advance = advance;
+        m_height = height;
+    }
+
+    /*! @brief Returns height of a line, zero until metrics are set. */
+    int Height() const noexcept
+    {
+        return m_height;
+    }
+
+    /*! @brief Returns glyph drawn for the character. */
+    const Glyph &Find(const char character) const noexcept
+    {
+        return m_glyphs[Index(character)];
+    }
+
+    /*! @brief Returns width of the text in pixels. */
+    int Measure(const std::string_view text) const noexcept
+    {
+        int width = 0;
+        for (auto character : text)
+        {
+            width += Find(character).advance;
+        }
+        return width;
+    }
+
+    /**
+     * @brief Lay out a line of text, glyphs not uploaded yet are skipped.
+     * @param text Text to lay out.
+     * @param origin Top left corner of the line.
+     * @param func Callable invoked as func(const SDL_Rect &src, const SDL_Rect &dst) per glyph.
+     * @param scale Scale of glyphs.
+     */
+    template <typename Func>
+    void Layout(const std::string_view text, const SDL_Point origin, Func &&func, const float scale = 1.f) const
+    {
+        if (!m_atlas)
+        {
+            return;
+        }
+        int pen = 0;
+        for (auto character : text)
+        {
+            auto &glyph = Find(character);
+            if (auto src = m_atlas->Rect(glyph.region); src.w)
+            {
+                SDL_Rect dst{origin.x + static_cast<int>(pen * scale), origin.y, static_cast<int>(src.w * scale),
+                             static_cast<int>(src.h * scale)};
+                func(src, dst);
+            }
+            pen += glyph.advance;
+        }
+    }
+
+private:
+    static std::size_t Index(const char character) noexcept
+    {
+        return static_cast<std::size_t>(character < first || character > last ? fallback - first : character - first);
+    }
+
+    const Atlas *m_atlas = nullptr;
+    std::array<Glyph, count> m_glyphs{};
+    int m_height = 0;
+};
+} // namespace ssecs::sdl
+
+#endif // GLYPH_CACHE_HPP
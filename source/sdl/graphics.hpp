@@ -1,16 +1,49 @@
 #ifndef GRAPHIC_HPP
 #define GRAPHIC_HPP
 
+#include <algorithm>
 #include <array>
+#include <bitset>
+#include <cstdint>
+#include <limits>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include <SDL_render.h>
+#include <SDL_version.h>
 
 #include "config.hpp"
 #include "fwd.hpp"
+#include "profiler.hpp"
 
 namespace ssecs::sdl
 {
+/*! @brief Queued texture copy, see Graphics::PushToLayer. */
+struct DrawCommand
+{
+    std::size_t layer;
+    SDL_Texture *texture;
+    SDL_Rect src_rect;
+    SDL_FRect dst_rect;
+    SDL_RendererFlip flip;
+    Uint8 alpha;
+    std::uint32_t order;
+};
+
+/*! @brief Layer work done during the last frame. */
+struct LayerStatistics
+{
+    std::size_t cleared = 0;
+    std::size_t composited = 0;
+};
+
+/**
+ * @brief The Graphics class.
+ * Renders into SDL_RENDER_LAYERS window sized layers composited at the end of the frame.
+ * Only layers that were drawn to are cleared and composited. Static layers keep their
+ * content between frames until InvalidateLayer.
+ */
 class Graphics
 {
     friend Game;
@@ -53,6 +86,9 @@ private:
             }
             SDL_SetTextureBlendMode(layer, SDL_BLENDMODE_BLEND);
         }
+        // New textures hold garbage.
+        m_clearLayers.set();
+        m_contentLayers.reset();
     }
 
     static void DestroyLayers()
@@ -67,15 +103,12 @@ private:
     }
     static void OnRenderStart()
     {
-        // clear all layers textures.
-        for (auto &layer : m_layers)
-        {
-            if (SDL_SetRenderTarget(m_renderer, layer))
-            {
-                SDL_THROW();
-            }
-            TargetClear();
-        }
+        SSECS_PROFILE("Graphics::OnRenderStart");
+        // Dynamic layers drawn last frame are cleared lazily, when they are bound again.
+        auto dynamic = m_contentLayers & ~m_staticLayers;
+        m_clearLayers |= dynamic;
+        m_contentLayers &= m_staticLayers;
+
         // reset renderer
         ResetRenderer();
 
@@ -88,6 +121,13 @@ private:
             SDL_THROW();
         }
         m_currentLayer = layer;
+        if (m_clearLayers.test(layer))
+        {
+            TargetClear();
+            m_clearLayers.reset(layer);
+            m_frameStatistics.cleared++;
+        }
+        m_contentLayers.set(layer);
     }
 
     static void ResetRenderer()
@@ -99,24 +139,125 @@ private:
     }
     static void TargetClear()
     {
+        Uint8 r, g, b, a;
+        SDL_GetRenderDrawColor(m_renderer, &r, &g, &b, &a);
+        SDL_SetRenderDrawColor(m_renderer, 0, 0, 0, SDL_ALPHA_TRANSPARENT);
         SDL_RenderClear(m_renderer);
+        SDL_SetRenderDrawColor(m_renderer, r, g, b, a);
     }
 
     static void RenderPresent()
     {
+        SSECS_PROFILE("Graphics::RenderPresent");
         SDL_RenderPresent(m_renderer);
     }
     static void DrawLayers()
     {
+        SSECS_PROFILE("Graphics::DrawLayers");
         ResetRenderer();
         TargetClear();
-        for (auto layer : m_layers)
+        for (std::size_t layer = 0; layer < m_layers.size(); layer++)
+        {
+            if (!m_contentLayers.test(layer))
+            {
+                continue;
+            }
+            if (SDL_RenderCopy(m_renderer, m_layers[layer], nullptr, nullptr))
+            {
+                SDL_THROW();
+            }
+            m_frameStatistics.composited++;
+        }
+        m_statistics = m_frameStatistics;
+        m_frameStatistics = {};
+        m_currentLayer = reset_layer;
+    }
+
+    /**
+     * @brief Submit queued commands of each layer in order they were pushed.
+     * Each layer is bound once, consecutive commands sharing texture state go in one batch,
+     * so paint order of overlapping sprites is kept.
+     * Geometry carries alpha in vertex colors, only the fallback path sets it per batch.
+     */
+    static void Flush()
+    {
+        SSECS_PROFILE("Graphics::Flush");
+        std::sort(m_commands.begin(), m_commands.end(), [](const DrawCommand &lhs, const DrawCommand &rhs) {
+            return std::tie(lhs.layer, lhs.order) < std::tie(rhs.layer, rhs.order);
+        });
+
+        for (auto first = m_commands.begin(); first != m_commands.end();)
+        {
+            auto last = std::find_if(first, m_commands.end(), [first](const DrawCommand &command) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+                return command.layer != first->layer || command.texture != first->texture;
+#else
+                return command.layer != first->layer || command.texture != first->texture ||
+                       command.alpha != first->alpha;
+#endif
+            });
+            if (first->layer != m_currentLayer)
+            {
+                RenderTarget(first->layer);
+            }
+            SubmitBatch(&*first, static_cast<std::size_t>(last - first));
+            first = last;
+        }
+        m_commands.clear();
+    }
+
+    static void SubmitBatch(const DrawCommand *commands, const std::size_t count)
+    {
+        auto texture = commands->texture;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+        int w, h;
+        SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
+        m_vertices.clear();
+        m_indices.clear();
+        for (std::size_t index = 0; index < count; index++)
         {
-            if (SDL_RenderCopy(m_renderer, layer, nullptr, nullptr))
+            auto &command = commands[index];
+            auto &src = command.src_rect;
+            auto &dst = command.dst_rect;
+            float u0 = static_cast<float>(src.x) / w, u1 = static_cast<float>(src.x + src.w) / w;
+            float v0 = static_cast<float>(src.y) / h, v1 = static_cast<float>(src.y + src.h) / h;
+            if (command.flip & SDL_FLIP_HORIZONTAL)
+            {
+                std::swap(u0, u1);
+            }
+            if (command.flip & SDL_FLIP_VERTICAL)
+            {
+                std::swap(v0, v1);
+            }
+            SDL_Color color{255, 255, 255, command.alpha};
+            auto base = static_cast<int>(m_vertices.size());
+            m_vertices.push_back({{dst.x, dst.y}, color, {u0, v0}});
+            m_vertices.push_back({{dst.x + dst.w, dst.y}, color, {u1, v0}});
+            m_vertices.push_back({{dst.x + dst.w, dst.y + dst.h}, color, {u1, v1}});
+            m_vertices.push_back({{dst.x, dst.y + dst.h}, color, {u0, v1}});
+            for (auto corner : {0, 1, 2, 0, 2, 3})
+            {
+                m_indices.push_back(base + corner);
+            }
+        }
+        if (SDL_RenderGeometry(m_renderer, texture, m_vertices.data(), static_cast<int>(m_vertices.size()),
+                               m_indices.data(), static_cast<int>(m_indices.size())))
+        {
+            SDL_THROW();
+        }
+#else
+        SDL_SetTextureAlphaMod(texture, commands->alpha);
+        for (std::size_t index = 0; index < count; index++)
+        {
+            auto &command = commands[index];
+            if (SDL_RenderCopyExF(m_renderer, texture, &command.src_rect, &command.dst_rect, 0, nullptr,
+                                  command.flip))
             {
                 SDL_THROW();
             }
         }
+        SDL_SetTextureAlphaMod(texture, SDL_ALPHA_OPAQUE);
+#endif
     }
 
     static void DestroyData()
@@ -179,6 +320,27 @@ public:
             SDL_THROW();
         }
     }
+    /**
+     * @brief Queue texture copy, it is submitted after the scene render.
+     * @note Draw order inside a layer is kept, consecutive commands with the same texture are one batch.
+     * Queued commands are drawn over immediate draws of the same layer.
+     * @param layer Render layer.
+     * @param texture Source texture.
+     * @param src_rect Source rect.
+     * @param dst_rect Destination rect in window.
+     * @param flip Flip of the copy.
+     * @param alpha Alpha modulation.
+     */
+    static void PushToLayer(std::size_t layer, SDL_Texture *texture, const SDL_Rect &src_rect, const SDL_Rect &dst_rect,
+                            const SDL_RendererFlip flip = SDL_FLIP_NONE, const Uint8 alpha = SDL_ALPHA_OPAQUE)
+    {
+        SSECS_ASSERT(layer < SDL_RENDER_LAYERS);
+        SDL_FRect dst{static_cast<float>(dst_rect.x), static_cast<float>(dst_rect.y), static_cast<float>(dst_rect.w),
+                      static_cast<float>(dst_rect.h)};
+        m_commands.push_back(
+            {layer, texture, src_rect, dst, flip, alpha, static_cast<std::uint32_t>(m_commands.size())});
+    }
+
     static void RenderToLayerF(std::size_t layer, SDL_Texture *texture, const SDL_Rect *src_rect = nullptr,
                                const SDL_FRect *dst_rect = nullptr, const SDL_RendererFlip flip = SDL_FLIP_NONE)
     {
@@ -192,6 +354,106 @@ public:
         }
     }
 
+    /**
+     * @brief Keep layer content between frames.
+     * Static layer is cleared only by InvalidateLayer or when window is resized.
+     * @param layer Render layer.
+     * @param isStatic True to keep content.
+     */
+    static void SetLayerStatic(std::size_t layer, const bool isStatic = true)
+    {
+        SSECS_ASSERT(layer < SDL_RENDER_LAYERS);
+        m_staticLayers.set(layer, isStatic);
+    }
+
+    /**
+     * @brief Drop layer content, layer is cleared when it is drawn to next time.
+     * @param layer Render layer.
+     */
+    static void InvalidateLayer(std::size_t layer)
+    {
+        SSECS_ASSERT(layer < SDL_RENDER_LAYERS);
+        m_clearLayers.set(layer);
+        m_contentLayers.reset(layer);
+        if (m_currentLayer == layer)
+        {
+            m_currentLayer = reset_layer;
+        }
+    }
+
+    /**
+     * @brief Check whether layer holds something to composite.
+     * @param layer Render layer.
+     * @return True if layer was drawn to this frame or is static and still valid.
+     */
+    static bool LayerHasContent(std::size_t layer)
+    {
+        SSECS_ASSERT(layer < SDL_RENDER_LAYERS);
+        return m_contentLayers.test(layer);
+    }
+
+    /*! @brief Returns count of layers cleared and composited during the last frame. */
+    static LayerStatistics Statistics() noexcept
+    {
+        return m_statistics;
+    }
+
+    /**
+     * @brief Create texture that can be rendered to.
+     * @param w Width in pixels.
+     * @param h Height in pixels.
+     * @return Transparent blended texture.
+     */
+    static SDL_Texture *CreateTarget(const int w, const int h)
+    {
+        auto texture = SDL_CreateTexture(m_renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!texture)
+        {
+            SDL_THROW();
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        return texture;
+    }
+
+    /**
+     * @brief Bind texture as render target and clear it.
+     * @note Current layer is reset, next draw to layer binds it again.
+     * @param target Texture created by CreateTarget.
+     */
+    static void ClearTarget(SDL_Texture *target)
+    {
+        if (SDL_SetRenderTarget(m_renderer, target))
+        {
+            SDL_THROW();
+        }
+        m_currentLayer = reset_layer;
+        TargetClear();
+    }
+
+    /**
+     * @brief Copy texture to target texture.
+     * @param target Texture bound by ClearTarget.
+     * @param texture Source texture.
+     * @param src_rect Source rect.
+     * @param dst_rect Destination rect in target.
+     */
+    static void RenderToTarget(SDL_Texture *target, SDL_Texture *texture, const SDL_Rect *src_rect,
+                               const SDL_Rect *dst_rect)
+    {
+        if (SDL_GetRenderTarget(m_renderer) != target)
+        {
+            if (SDL_SetRenderTarget(m_renderer, target))
+            {
+                SDL_THROW();
+            }
+            m_currentLayer = reset_layer;
+        }
+        if (SDL_RenderCopy(m_renderer, texture, src_rect, dst_rect))
+        {
+            SDL_THROW();
+        }
+    }
+
     static void DrawRectToLayer(std::size_t layer, const SDL_Rect *rect)
     {
         if (layer != m_currentLayer)
@@ -264,6 +526,16 @@ private:
     static inline SDL_Renderer *m_renderer = nullptr;
     static inline std::array<SDL_Texture *, SDL_RENDER_LAYERS> m_layers{};
     static inline std::size_t m_currentLayer = reset_layer;
+    static inline std::bitset<SDL_RENDER_LAYERS> m_staticLayers;
+    static inline std::bitset<SDL_RENDER_LAYERS> m_contentLayers;
+    static inline std::bitset<SDL_RENDER_LAYERS> m_clearLayers;
+    static inline LayerStatistics m_statistics;
+    static inline LayerStatistics m_frameStatistics;
+    static inline std::vector<DrawCommand> m_commands;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    static inline std::vector<SDL_Vertex> m_vertices;
+    static inline std::vector<int> m_indices;
+#endif
 };
 
 } // namespace ssecs::sdl
@@ -0,0 +1,100 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include "../../entt/entity/group.hpp"
+#include "../../entt/entity/view.hpp"
+#include "threadpool.hpp"
+
+namespace ssecs::sdl
+{
+/*! @brief Default count of entities one job processes at least. */
+inline constexpr const std::size_t parallel_grain = 128;
+
+/**
+ * @brief Parallel version of view.each.
+ * Splits entities of the smallest pool in chunks and runs func on pool workers.
+ * Func has the same signature as for view.each, it's invoked concurrently for different entities,
+ * so it may write only to components of its own entity.
+ * @param pool Thread pool, in single-threaded mode it's the same as view.each.
+ * @param view View to iterate.
+ * @param func Callable invoked as func(entity, Component &...) or func(Component &...).
+ * @param grain Count of entities one job processes at least.
+ */
+template <typename Entity, typename... Exclude, typename... Component, typename Func>
+void parallel_each(ThreadPool &pool, const entt::basic_view<Entity, entt::exclude_t<Exclude...>, Component...> &view,
+                   Func func, const std::size_t grain = parallel_grain)
+{
+    constexpr const bool isSingle = sizeof...(Exclude) == 0 && sizeof...(Component) == 1;
+
+    const Entity *entities = nullptr;
+    std::size_t size = 0;
+    if constexpr (isSingle)
+    {
+        entities = view.data();
+        size = view.size();
+    }
+    else
+    {
+        size = std::numeric_limits<std::size_t>::max();
+        ((view.template size<Component>() < size
+              ? (entities = view.template data<Component>(), size = view.template size<Component>())
+              : size),
+         ...);
+    }
+
+    pool.ParallelFor(size, grain, [&view, &func, entities](const std::size_t begin, const std::size_t end) {
+        for (auto index = begin; index < end; index++)
+        {
+            const auto entity = entities[index];
+            if constexpr (!isSingle)
+            {
+                if (!view.contains(entity))
+                {
+                    continue;
+                }
+            }
+            if constexpr (std::is_invocable_v<Func &, decltype(view.template get<Component>(entity))...>)
+            {
+                func(view.template get<Component>(entity)...);
+            }
+            else
+            {
+                func(entity, view.template get<Component>(entity)...);
+            }
+        }
+    });
+}
+
+/**
+ * @brief Parallel version of group.each, see parallel_each for views.
+ * @param func Callable invoked as func(entity, Owned &..., Get &...) or func(Owned &..., Get &...).
+ */
+template <typename Entity, typename... Exclude, typename... Get, typename... Owned, typename Func>
+void parallel_each(ThreadPool &pool,
+                   const entt::basic_group<Entity, entt::exclude_t<Exclude...>, entt::get_t<Get...>, Owned...> &group,
+                   Func func, const std::size_t grain = parallel_grain)
+{
+    const auto *entities = group.data();
+    pool.ParallelFor(group.size(), grain, [&group, &func, entities](const std::size_t begin, const std::size_t end) {
+        for (auto index = begin; index < end; index++)
+        {
+            const auto entity = entities[index];
+            if constexpr (std::is_invocable_v<Func &, decltype(group.template get<Owned>(entity))...,
+                                              decltype(group.template get<Get>(entity))...>)
+            {
+                func(group.template get<Owned>(entity)..., group.template get<Get>(entity)...);
+            }
+            else
+            {
+                func(entity, group.template get<Owned>(entity)..., group.template get<Get>(entity)...);
+            }
+        }
+    });
+}
+} // namespace ssecs::sdl
+
+#endif // PARALLEL_HPP
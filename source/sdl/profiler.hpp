@@ -0,0 +1,225 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string_view>
+
+#include <SDL_timer.h>
+
+#include "fwd.hpp"
+
+namespace ssecs::sdl
+{
+/**
+ * @brief The Profiler class.
+ * Accumulates time of named zones during a frame on high resolution counter
+ * and keeps last history frames in a ring buffer.
+ * Zones are declared with SSECS_PROFILE or SSECS_PROFILE_FUNCTION,
+ * both expand to nothing if SSECS_DISABLE_PROFILER is defined.
+ */
+class Profiler
+{
+    friend Game;
+
+public:
+    using zone_type = std::size_t;
+
+    static constexpr const std::size_t max_zones = 64;
+    static constexpr const std::size_t history = 240;
+
+    /**
+     * @brief Find or register zone.
+     * @param name Zone name, must outlive the profiler (string literal or __func__).
+     * @return Zone id, max_zones if there is no room left.
+     */
+    static zone_type Register(const char *name)
+    {
+        std::lock_guard lock{m_mutex};
+        auto count = m_count.load(std::memory_order_relaxed);
+        for (zone_type zone = 0; zone < count; zone++)
+        {
+            if (std::strcmp(m_names[zone], name) == 0)
+            {
+                return zone;
+            }
+        }
+        if (count == max_zones)
+        {
+            return max_zones;
+        }
+        m_names[count] = name;
+        m_count.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    /*! @brief Add counter ticks to zone of current frame. */
+    static void Add(const zone_type zone, const Uint64 ticks) noexcept
+    {
+        if (zone < max_zones)
+        {
+            m_accumulators[zone].fetch_add(ticks, std::memory_order_relaxed);
+        }
+    }
+
+    /*! @brief Returns count of registered zones. */
+    static std::size_t Zones() noexcept
+    {
+        return m_count.load(std::memory_order_acquire);
+    }
+
+    /*! @brief Returns zone name. */
+    static const char *Name(const zone_type zone) noexcept
+    {
+        return m_names[zone];
+    }
+
+    /*! @brief Returns zone time of the last frame in milliseconds. */
+    static float Last(const zone_type zone) noexcept
+    {
+        return m_filled ? m_frames[Previous(m_head)][zone] : 0.f;
+    }
+
+    /*! @brief Returns zone time averaged over recorded frames in milliseconds. */
+    static float Average(const zone_type zone) noexcept
+    {
+        float sum = 0;
+        for (std::size_t frame = 0; frame < m_filled; frame++)
+        {
+            sum += m_frames[frame][zone];
+        }
+        return m_filled ? sum / m_filled : 0.f;
+    }
+
+    /*! @brief Returns whole frame time averaged over recorded frames in milliseconds. */
+    static float FrameAverage() noexcept
+    {
+        float sum = 0;
+        for (std::size_t frame = 0; frame < m_filled; frame++)
+        {
+            sum += m_totals[frame];
+        }
+        return m_filled ? sum / m_filled : 0.f;
+    }
+
+    /**
+     * @brief Write recorded frames, oldest first, one row per frame.
+     * @param path Path to csv file.
+     * @return True in success.
+     */
+    static bool DumpCsv(std::string_view path)
+    {
+        std::ofstream file;
+        file.open(path.data(), std::ofstream::trunc);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        auto count = Zones();
+        file << "frame,total_ms";
+        for (zone_type zone = 0; zone < count; zone++)
+        {
+            file << "," << m_names[zone];
+        }
+        file << "\n";
+
+        auto first = m_filled < history ? 0 : m_head;
+        for (std::size_t index = 0; index < m_filled; index++)
+        {
+            auto frame = (first + index) % history;
+            file << index << "," << m_totals[frame];
+            for (zone_type zone = 0; zone < count; zone++)
+            {
+                file << "," << m_frames[frame][zone];
+            }
+            file << "\n";
+        }
+        return true;
+    }
+
+    /*! @brief Convert counter ticks to milliseconds. */
+    static float Milliseconds(const Uint64 ticks) noexcept
+    {
+        return static_cast<float>(static_cast<double>(ticks) * 1000.0 / SDL_GetPerformanceFrequency());
+    }
+
+private:
+    static std::size_t Previous(const std::size_t frame) noexcept
+    {
+        return (frame + history - 1) % history;
+    }
+
+    static void BeginFrame() noexcept
+    {
+        m_frameStart = SDL_GetPerformanceCounter();
+    }
+
+    static void EndFrame() noexcept
+    {
+        auto &frame = m_frames[m_head];
+        auto count = Zones();
+        for (zone_type zone = 0; zone < count; zone++)
+        {
+            frame[zone] = Milliseconds(m_accumulators[zone].exchange(0, std::memory_order_relaxed));
+        }
+        m_totals[m_head] = Milliseconds(SDL_GetPerformanceCounter() - m_frameStart);
+
+        m_head = (m_head + 1) % history;
+        if (m_filled < history)
+        {
+            m_filled++;
+        }
+    }
+
+    static inline std::mutex m_mutex;
+    static inline std::atomic<std::size_t> m_count{0};
+    static inline std::array<const char *, max_zones> m_names{};
+    static inline std::array<std::atomic<Uint64>, max_zones> m_accumulators{};
+
+    static inline std::array<std::array<float, max_zones>, history> m_frames{};
+    static inline std::array<float, history> m_totals{};
+    static inline std::size_t m_head = 0;
+    static inline std::size_t m_filled = 0;
+    static inline Uint64 m_frameStart = 0;
+};
+
+/*! @brief Adds time between construction and destruction to the zone. */
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const Profiler::zone_type zone) noexcept
+        : m_zone{zone}, m_start{SDL_GetPerformanceCounter()}
+    {
+    }
+    ~ProfileScope()
+    {
+        Profiler::Add(m_zone, SDL_GetPerformanceCounter() - m_start);
+    }
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    Profiler::zone_type m_zone;
+    Uint64 m_start;
+};
+} // namespace ssecs::sdl
+
+#define SSECS_CONCAT_IMPL(lhs, rhs) lhs##rhs
+#define SSECS_CONCAT(lhs, rhs) SSECS_CONCAT_IMPL(lhs, rhs)
+
+#ifndef SSECS_DISABLE_PROFILER
+#define SSECS_PROFILE(name)                                                                                          \
+    static const auto SSECS_CONCAT(ssecs_zone_, __LINE__) = ::ssecs::sdl::Profiler::Register(name);                  \
+    const ::ssecs::sdl::ProfileScope SSECS_CONCAT(ssecs_scope_, __LINE__)                                             \
+    {                                                                                                                \
+        SSECS_CONCAT(ssecs_zone_, __LINE__)                                                                          \
+    }
+#else
+#define SSECS_PROFILE(name) ((void)0)
+#endif
+#define SSECS_PROFILE_FUNCTION() SSECS_PROFILE(__func__)
+
+#endif // PROFILER_HPP
@@ -14,9 +14,38 @@
 namespace ssecs::sdl
 {
 
-/*! @brief Texture Loader struct. */
+/**
+ * @brief Texture Loader struct.
+ * Image, GlyphSurface, Font and Music don't touch the renderer, AssetLoader runs them on its thread.
+ * Sprite and Text create textures, so they run on the main thread only.
+ */
 struct ResourceLoader
 {
+    /*! @brief Decode image file to a surface. */
+    static SDL_Surface *Image(std::string_view path)
+    {
+        auto surface = IMG_Load(std::string{path}.c_str());
+        if (!surface)
+        {
+            SDL_THROW();
+        }
+
+        return surface;
+    }
+
+    /*! @brief Render one glyph to a surface of font height. */
+    static SDL_Surface *GlyphSurface(TTF_Font *font, const char character,
+                                     SDL_Color color = {0, 0, 0, SDL_ALPHA_OPAQUE})
+    {
+        auto surface = TTF_RenderGlyph_Blended(font, static_cast<Uint16>(character), color);
+        if (!surface)
+        {
+            SDL_THROW();
+        }
+
+        return surface;
+    }
+
     static SDL_Texture *Sprite(std::string_view path)
     {
         auto texture = IMG_LoadTexture(Graphics::Renderer(), path.data());
@@ -41,18 +70,18 @@ struct ResourceLoader
 
     static SDL_Texture *Text(TTF_Font *font, std::string_view text, SDL_Color color = {0, 0, 0, SDL_ALPHA_OPAQUE})
     {
-        auto surface = TTF_RenderUTF8_Blended(font, text.data(), color);
+        // TTF needs a null terminated string, a view may be a part of one.
+        auto surface = TTF_RenderUTF8_Blended(font, std::string{text}.c_str(), color);
         if (!surface)
         {
             SDL_THROW();
         }
-
         auto texture = SDL_CreateTextureFromSurface(sdl::Graphics::Renderer(), surface);
+        SDL_FreeSurface(surface);
         if (!texture)
         {
             SDL_THROW();
         }
-        SDL_FreeSurface(surface);
         return texture;
     }
     static Mix_Music *Music(std::string_view path)
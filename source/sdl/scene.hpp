@@ -9,17 +9,17 @@ namespace ssecs::sdl
  * Base process deliver interface for inheritance.
  * Override methods of this class to make own game logic.
  * Functions invoked in this way:
- * * FixedUpdate();
- * * Update();
+ * * FixedUpdate(); - zero or more times per frame with fixed dt
+ * * Update(); - once per frame with real dt
  * * InputUpdate();
- * * Render();
+ * * Render(); - alpha is how far real time is between the last two fixed updates
  */
 class BasicScene
 {
 public:
     virtual ~BasicScene() = default;
 
-    virtual void FixedUpdate()
+    virtual void FixedUpdate([[maybe_unused]] const float dt)
     {
     }
     virtual void Update([[maybe_unused]] const float dt)
@@ -28,7 +28,7 @@ public:
     virtual void InputUpdate()
     {
     }
-    virtual void Render()
+    virtual void Render([[maybe_unused]] const float alpha)
     {
     }
 };
@@ -0,0 +1,202 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "../../entt/core/type_info.hpp"
+#include "../../entt/entity/registry.hpp"
+#include "threadpool.hpp"
+
+namespace ssecs::sdl
+{
+/*! @brief Components a system only reads. */
+template <typename... Components>
+struct Read
+{
+};
+
+/*! @brief Components a system reads and writes. */
+template <typename... Components>
+struct Write
+{
+};
+
+/**
+ * @brief The Scheduler class.
+ * Runs systems of one phase (FixedUpdate, Update) on the ThreadPool.
+ * Each system declares components it reads and writes. A system waits for every earlier system
+ * it conflicts with (both touch a component and at least one writes it), so the result is the
+ * same as running them one by one in order they were added; systems without conflicts run in parallel.
+ * Systems must not create, destroy, assign or remove while the phase runs, use Defer instead.
+ */
+class Scheduler
+{
+public:
+    using system_type = std::function<void(float)>;
+    using id_type = ENTT_ID_TYPE;
+
+    Scheduler(entt::registry &registry, ThreadPool &pool) : m_registry{registry}, m_pool{pool}
+    {
+    }
+
+    /**
+     * @brief Add system to the end of the phase.
+     * @param system Callable taking dt.
+     */
+    template <typename... Reads, typename... Writes>
+    void Add(Read<Reads...>, Write<Writes...>, system_type system)
+    {
+        // Views create missing pools, do it now while nothing else runs.
+        (m_registry.template view<Reads>(), ...);
+        (m_registry.template view<Writes>(), ...);
+        m_systems.push_back({std::move(system), {entt::type_info<Reads>::id()...},
+                             {entt::type_info<Writes>::id()...}, false});
+        m_waves.clear();
+    }
+
+    /**
+     * @brief Add system which runs alone, for systems touching too much to declare,
+     * like ones that publish signals.
+     */
+    void AddExclusive(system_type system)
+    {
+        m_systems.push_back({std::move(system), {}, {}, true});
+        m_waves.clear();
+    }
+
+    /**
+     * @brief Run all systems, then apply deferred commands.
+     * @param dt Delta time passed to each system.
+     */
+    void Run(const float dt)
+    {
+        if (m_waves.empty())
+        {
+            Build();
+        }
+        m_dt = dt;
+        auto run = [](void *context, const std::size_t system, std::size_t) {
+            auto scheduler = static_cast<Scheduler *>(context);
+            scheduler->m_systems[system].run(scheduler->m_dt);
+        };
+        for (const auto &wave : m_waves)
+        {
+            Batch batch;
+            for (std::size_t index = 1; index < wave.size(); index++)
+            {
+                m_pool.Submit(batch, run, this, wave[index]);
+            }
+            m_systems[wave.front()].run(dt);
+            m_pool.Wait(batch);
+        }
+        Sync();
+    }
+
+    /*! @brief Returns count of sequential steps the phase runs in. */
+    std::size_t Waves()
+    {
+        if (m_waves.empty())
+        {
+            Build();
+        }
+        return m_waves.size();
+    }
+
+    /**
+     * @brief Queue structural change to run after the current phase on the main thread.
+     * Safe to call from any system.
+     */
+    static void Defer(std::function<void()> command)
+    {
+        std::lock_guard lock{m_commandsMutex};
+        m_commands.push_back(std::move(command));
+    }
+
+private:
+    struct System
+    {
+        system_type run;
+        std::vector<id_type> reads;
+        std::vector<id_type> writes;
+        bool exclusive;
+    };
+
+    static bool Contains(const std::vector<id_type> &ids, const id_type id) noexcept
+    {
+        return std::find(ids.cbegin(), ids.cend(), id) != ids.cend();
+    }
+
+    static bool Conflict(const System &lhs, const System &rhs) noexcept
+    {
+        if (lhs.exclusive || rhs.exclusive)
+        {
+            return true;
+        }
+        for (auto id : lhs.writes)
+        {
+            if (Contains(rhs.reads, id) || Contains(rhs.writes, id))
+            {
+                return true;
+            }
+        }
+        for (auto id : rhs.writes)
+        {
+            if (Contains(lhs.reads, id))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*! @brief Group systems in waves, each after the last wave it conflicts with. */
+    void Build()
+    {
+        std::vector<std::size_t> wave(m_systems.size(), 0);
+        for (std::size_t system = 0; system < m_systems.size(); system++)
+        {
+            for (std::size_t before = 0; before < system; before++)
+            {
+                if (Conflict(m_systems[before], m_systems[system]))
+                {
+                    wave[system] = std::max(wave[system], wave[before] + 1);
+                }
+            }
+            if (wave[system] == m_waves.size())
+            {
+                m_waves.emplace_back();
+            }
+            m_waves[wave[system]].push_back(system);
+        }
+    }
+
+    /*! @brief Apply deferred commands in order they came. */
+    static void Sync()
+    {
+        std::vector<std::function<void()>> commands;
+        {
+            std::lock_guard lock{m_commandsMutex};
+            commands.swap(m_commands);
+        }
+        for (auto &command : commands)
+        {
+            command();
+        }
+    }
+
+    entt::registry &m_registry;
+    ThreadPool &m_pool;
+    std::vector<System> m_systems;
+    std::vector<std::vector<std::size_t>> m_waves;
+    float m_dt = 0;
+
+    static inline std::mutex m_commandsMutex;
+    static inline std::vector<std::function<void()>> m_commands;
+};
+} // namespace ssecs::sdl
+
+#endif // SCHEDULER_HPP
@@ -1,13 +1,20 @@
 #ifndef SDL_HPP
 #define SDL_HPP
 
+#include "asset_loader.hpp"
+#include "atlas.hpp"
 #include "events.hpp"
 #include "framerate.hpp"
 #include "game.hpp"
+#include "glyph_cache.hpp"
 #include "graphics.hpp"
 #include "instances.hpp"
+#include "parallel.hpp"
+#include "profiler.hpp"
 #include "scene.hpp"
 #include "resource_loader.hpp"
+#include "scheduler.hpp"
+#include "threadpool.hpp"
 #include "timer.hpp"
 
 #endif // SDL_HPP
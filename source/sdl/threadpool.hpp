@@ -0,0 +1,277 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ssecs::sdl
+{
+/**
+ * @brief Counter of unfinished jobs submitted together.
+ * Must outlive ThreadPool::Wait on it.
+ */
+class Batch
+{
+    friend class ThreadPool;
+
+public:
+    /*! @brief Returns true if every job of the batch is finished. */
+    bool Done() const noexcept
+    {
+        return m_pending.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    std::atomic<std::size_t> m_pending{0};
+};
+
+/**
+ * @brief The ThreadPool class.
+ * Work-stealing pool: every worker has its own queue, takes the newest job from it
+ * and steals the oldest ones from other queues when it is empty.
+ * Threads outside the pool submit to a shared queue. Waiting thread runs jobs instead of blocking,
+ * so jobs may submit and wait for other jobs.
+ * Without workers every job runs inline, which is the single-threaded mode.
+ */
+class ThreadPool
+{
+public:
+    using run_type = void (*)(void *context, std::size_t begin, std::size_t end);
+
+    /*! @brief Create pool without workers. */
+    ThreadPool() = default;
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /*! @brief Invoke Stop. */
+    ~ThreadPool()
+    {
+        Stop();
+    }
+
+    /**
+     * @brief Start worker threads, stopping current ones first.
+     * @param workers Count of threads besides the calling one, 0 is single-threaded mode.
+     */
+    void Start(const std::size_t workers)
+    {
+        Stop();
+        m_stop = false;
+        m_queues.clear();
+        for (std::size_t index = 0; index <= workers; index++)
+        {
+            m_queues.push_back(std::make_unique<Queue>());
+        }
+        m_threads.reserve(workers);
+        for (std::size_t index = 1; index <= workers; index++)
+        {
+            m_threads.emplace_back([this, index] { Work(index); });
+        }
+    }
+
+    /*! @brief Finish queued jobs and join worker threads. */
+    void Stop()
+    {
+        {
+            std::lock_guard lock{m_sleepMutex};
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto &thread : m_threads)
+        {
+            thread.join();
+        }
+        m_threads.clear();
+    }
+
+    /*! @brief Returns count of worker threads. */
+    std::size_t Workers() const noexcept
+    {
+        return m_threads.size();
+    }
+
+    /**
+     * @brief Queue the job, or run it right away if there are no workers.
+     * @param batch Batch to count the job in.
+     * @param run Function invoked as run(context, begin, end).
+     */
+    void Submit(Batch &batch, const run_type run, void *context, const std::size_t begin = 0,
+                const std::size_t end = 0)
+    {
+        if (m_threads.empty())
+        {
+            run(context, begin, end);
+            return;
+        }
+        batch.m_pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            auto &queue = *m_queues[Current()];
+            std::lock_guard lock{queue.mutex};
+            // Counted before the job is visible, so Pop taking it never drives the counter below zero.
+            m_queued.fetch_add(1, std::memory_order_release);
+            queue.jobs.push_back({run, context, begin, end, &batch});
+        }
+        // Sleeping worker either sees the job or is already waiting for the notification.
+        {
+            std::lock_guard lock{m_sleepMutex};
+        }
+        m_wake.notify_one();
+    }
+
+    /*! @brief Run queued jobs until every job of the batch is finished. */
+    void Wait(Batch &batch)
+    {
+        auto index = Current();
+        while (!batch.Done())
+        {
+            Job job;
+            if (Pop(index, job))
+            {
+                Execute(job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @brief Split [0, count) into chunks of at least grain items and process them in parallel.
+     * @param func Callable invoked as func(begin, end), the calling thread takes the first chunk.
+     */
+    template <typename Func>
+    void ParallelFor(const std::size_t count, const std::size_t grain, Func &&func)
+    {
+        if (!count)
+        {
+            return;
+        }
+        // A few chunks per thread, so stealing can even out uneven entities.
+        auto threads = Workers() + 1;
+        auto chunk = std::max({grain, std::size_t{1}, (count + threads * 4 - 1) / (threads * 4)});
+        if (m_threads.empty() || chunk >= count)
+        {
+            func(std::size_t{0}, count);
+            return;
+        }
+
+        using func_type = std::remove_reference_t<Func>;
+        auto run = [](void *context, const std::size_t begin, const std::size_t end) {
+            (*static_cast<func_type *>(context))(begin, end);
+        };
+        auto context = const_cast<void *>(static_cast<const void *>(std::addressof(func)));
+
+        Batch batch;
+        for (auto begin = chunk; begin < count; begin += chunk)
+        {
+            Submit(batch, run, context, begin, std::min(begin + chunk, count));
+        }
+        func(std::size_t{0}, chunk);
+        Wait(batch);
+    }
+
+private:
+    struct Job
+    {
+        run_type run;
+        void *context;
+        std::size_t begin;
+        std::size_t end;
+        Batch *batch;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    /*! @brief Returns queue of the calling thread, 0 for threads outside the pool. */
+    std::size_t Current() const noexcept
+    {
+        return t_pool == this ? t_queue : 0;
+    }
+
+    void Work(const std::size_t index)
+    {
+        t_pool = this;
+        t_queue = index;
+        while (true)
+        {
+            Job job;
+            if (Pop(index, job))
+            {
+                Execute(job);
+                continue;
+            }
+            std::unique_lock lock{m_sleepMutex};
+            m_wake.wait(lock, [this] { return m_stop || m_queued.load(std::memory_order_acquire); });
+            if (m_stop && !m_queued.load(std::memory_order_acquire))
+            {
+                return;
+            }
+        }
+    }
+
+    /*! @brief Take the newest job of own queue or steal the oldest job of another one. */
+    bool Pop(const std::size_t index, Job &job)
+    {
+        if (!m_queued.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        {
+            auto &queue = *m_queues[index];
+            std::lock_guard lock{queue.mutex};
+            if (!queue.jobs.empty())
+            {
+                job = queue.jobs.back();
+                queue.jobs.pop_back();
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        for (std::size_t offset = 1; offset < m_queues.size(); offset++)
+        {
+            auto &queue = *m_queues[(index + offset) % m_queues.size()];
+            std::lock_guard lock{queue.mutex};
+            if (!queue.jobs.empty())
+            {
+                job = queue.jobs.front();
+                queue.jobs.pop_front();
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void Execute(const Job &job)
+    {
+        job.run(job.context, job.begin, job.end);
+        job.batch->m_pending.fetch_sub(1, std::memory_order_release);
+    }
+
+    std::vector<std::thread> m_threads;
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::atomic<std::size_t> m_queued{0};
+    bool m_stop = false;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+
+    static inline thread_local const ThreadPool *t_pool = nullptr;
+    static inline thread_local std::size_t t_queue = 0;
+};
+} // namespace ssecs::sdl
+
+#endif // THREADPOOL_HPP
@@ -5,11 +5,11 @@
 
 namespace ssecs::sdl
 {
-/*! @brief Timer builded on SDL_GetTicks() */
+/*! @brief Timer builded on SDL_GetPerformanceCounter() */
 class Timer
 {
 private:
-    Uint32 m_previous{};
+    Uint64 m_previous{};
 
 public:
     /*! @brief Return ticks from init SDL subsystems !*/
@@ -18,22 +18,34 @@ public:
         return SDL_GetTicks();
     }
 
-    /*! @brief  !*/
-    Uint32 Started()
+    /*! @brief Return current value of high resolution counter !*/
+    static Uint64 Counter()
+    {
+        return SDL_GetPerformanceCounter();
+    }
+
+    /*! @brief Convert counter difference to seconds !*/
+    static double Seconds(const Uint64 counts)
+    {
+        return static_cast<double>(counts) / SDL_GetPerformanceFrequency();
+    }
+
+    /*! @brief Return counter value of last Record !*/
+    Uint64 Started()
     {
         return m_previous;
     }
 
-    /*! @brief Return time since last call ellapsed. !*/
-    Uint32 Ellapsed()
+    /*! @brief Return seconds since last Record. !*/
+    double Ellapsed()
     {
-        return SDL_GetTicks() - m_previous;
+        return Seconds(Counter() - m_previous);
     }
 
     /*! @brief Start recording !*/
     void Record()
     {
-        m_previous = SDL_GetTicks();
+        m_previous = Counter();
     }
 };
 } // namespace ssecs::sdl
@@ -11,8 +11,9 @@ void CameraCreate()
     camera.UpdateWindowSize(sdl::Graphics::Window());
 }
 
-void CameraFollow()
+void CameraFollow(const float alpha)
 {
+    SSECS_PROFILE_FUNCTION();
     if (CameraData::isFollowing)
     {
         auto playerView = registry.view<Player, Position, Sprite>();
@@ -20,7 +21,8 @@ void CameraFollow()
         auto cameraView = registry.view<Camera>();
         auto &activeCamera = cameraView.get(*cameraView.begin());
 
-        activeCamera.position.Set(position.position.x() + sprite.rect.w * sprite.scale.x() / 2,
-                                  position.position.y() + sprite.rect.h * sprite.scale.y() / 2);
+        auto center = position.Interpolated(alpha);
+        activeCamera.position.Set(center.x() + sprite.rect.w * sprite.scale.x() / 2,
+                                  center.y() + sprite.rect.h * sprite.scale.y() / 2);
     }
 }
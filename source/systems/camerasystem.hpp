@@ -2,6 +2,6 @@
 #define CAMERASYSTEM_HPP
 
 void CameraCreate();
-void CameraFollow();
+void CameraFollow(const float alpha);
 
 #endif // CAMERASYSTEM_HPP
@@ -90,120 +90,104 @@ bool AABB(const SDL_FRect &lhs, const SDL_FRect &rhs)
 
 void CollisionDetection()
 {
-    auto viewRect = registry.view<RectCollider, Position, CollisionLayer, Hierarchy, Active>();
-    for (auto &entity : viewRect)
-    {
+    SSECS_PROFILE_FUNCTION();
+    auto &broadphase = registry.ctx<BroadPhase>();
 
-        auto &&[prev_rect, prev_position, prev_layer, prev_hierarchy] =
-            viewRect.get<RectCollider, Position, CollisionLayer, Hierarchy>(entity);
-        SDL_FRect prev_frect{prev_position.position.x() + prev_rect.rect.x,
-                             prev_position.position.y() + prev_rect.rect.y, prev_rect.rect.w, prev_rect.rect.h};
-        for (auto &entt : viewRect)
+    broadphase.Clear();
+    ColliderGroup().each([&broadphase](const auto entity, const auto &rect, const auto &layer, const auto &position) {
+        if (!activation.Test(entity))
         {
-            if (entity != entt)
-            {
-
-                auto &&[rect, position, layer, hierarchy] =
-                    viewRect.get<RectCollider, Position, CollisionLayer, Hierarchy>(entt);
-                if (CollisionLayer::Matrix[layer.layer][prev_layer.layer] ||
-                    CollisionLayer::Matrix[prev_layer.layer][layer.layer])
-                {
-                    Vector2D parent_pos{};
-
-                    SDL_FRect frect{position.position.x() + parent_pos.x() + rect.rect.x,
-                                    position.position.y() + parent_pos.y() + rect.rect.y, rect.rect.w, rect.rect.h};
+            return;
+        }
+        broadphase.Insert(entity,
+                          {position.position.x() + rect.rect.x, position.position.y() + rect.rect.y, rect.rect.w,
+                           rect.rect.h},
+                          layer.layer);
+    });
 
-                    auto direction = AABBW(frect, prev_frect);
-                    if (direction.first != Vector2D::zero() && direction.second != Vector2D::zero())
-                    {
-                        registry.ctx<collision_signal>().publish(
-                            {entt, frect, direction},
-                            {entity,
-                             prev_frect,
-                             {Vector2D::zero() - direction.first, Vector2D::zero() - direction.second}});
-                    }
-                }
-            }
+    // AABBW isn't symmetric, so both orders of a pair are tested, as the pair loop did.
+    auto narrowphase = [](const BroadPhase::Proxy &lhs, const BroadPhase::Proxy &rhs) {
+        auto direction = AABBW(lhs.rect, rhs.rect);
+        if (direction.first != Vector2D::zero() && direction.second != Vector2D::zero())
+        {
+            registry.ctx<collision_signal>().publish(
+                {lhs.id, lhs.rect, direction},
+                {rhs.id, rhs.rect, {Vector2D::zero() - direction.first, Vector2D::zero() - direction.second}});
         }
-    }
+    };
+    broadphase.Pairs([&narrowphase](const auto &lhs, const auto &rhs) {
+        if (CollisionLayer::Matrix[lhs.layer][rhs.layer] || CollisionLayer::Matrix[rhs.layer][lhs.layer])
+        {
+            narrowphase(rhs, lhs);
+            narrowphase(lhs, rhs);
+        }
+    });
 }
 void CollisionTileDetection(float dt)
 {
-    auto viewRect = registry.view<RectCollider, Position, CollisionLayer, Velocity, Active>();
-    auto viewGrid = registry.view<TileGridCollider, Position, TileGrid, CollisionLayer, Active>();
-    for (auto rect_entt : viewRect)
+    SSECS_PROFILE_FUNCTION();
+    auto movers = MovementGroup();
+    auto colliders = ColliderGroup();
+    auto viewGrid = registry.view<TileGridCollider, Position, TileGrid, CollisionLayer>();
+    for (auto rect_entt : movers)
     {
-
-        auto &&[rect_pos, rect_collider, rect_vel, rect_layer] =
-            viewRect.get<Position, RectCollider, Velocity, CollisionLayer>(rect_entt);
+        if (!activation.Test(rect_entt) || !colliders.contains(rect_entt))
+        {
+            continue;
+        }
+        auto &&[rect_pos, rect_vel] = movers.get<Position, Velocity>(rect_entt);
+        auto &rect_collider = colliders.get<RectCollider>(rect_entt);
 
         SDL_FRect world_rect{rect_pos.position.x() + rect_vel.x * dt + rect_collider.rect.x,
                              rect_pos.position.y() + rect_vel.y * dt + rect_collider.rect.y, rect_collider.rect.w,
                              rect_collider.rect.h};
         for (auto grid_entt : viewGrid)
         {
-
+            if (!activation.Test(grid_entt))
+            {
+                continue;
+            }
             auto &&[grid_pos, tile_grid, tile_layer] = viewGrid.get<Position, TileGrid, CollisionLayer>(grid_entt);
-            if (true) // rect_entt != grid_entt && CollisionLayer::Matrix[rect_layer.layer][tile_layer.layer])
+            // Only walls affect movement, other tile layers have nothing to resolve.
+            if (tile_layer.layer != LayersID::WALLS)
             {
-                SDL_FRect world_tile{grid_pos.position.x(), grid_pos.position.y(),
-                                     tile_grid.tileSet->TileWidth() * tile_grid.scale.x(),
-                                     tile_grid.tileSet->TileHeight() * tile_grid.scale.y()};
-                int j = tile_grid.cell.size() - 1;
-                for (auto &row : tile_grid.cell)
-                {
-                    world_tile.y = grid_pos.position.y() + j * world_tile.h;
-                    int i = 0;
-                    for (auto &id : row)
-                    {
+                continue;
+            }
+            auto range = tile_grid.Cover(grid_pos.position, world_rect);
+            if (range.Empty())
+            {
+                continue;
+            }
 
-                        if (id)
+            auto size = tile_grid.CellSize();
+            SDL_FRect world_tile{grid_pos.position.x(), grid_pos.position.y(), size.x(), size.y()};
+            for (int j = range.top; j >= range.bottom; j--)
+            {
+                world_tile.y = grid_pos.position.y() + j * world_tile.h;
+                tile_grid.EachSolid(j, range.left, range.right, [&](const int i) {
+                    world_tile.x = grid_pos.position.x() + i * world_tile.w;
+                    auto direction = AABBW(world_rect, world_tile);
+                    if (direction.first != Vector2D::zero() && direction.second != Vector2D::zero())
+                    {
+                        if (direction.first == Vector2D::left() && rect_vel.x < 0)
                         {
-                            world_tile.x = grid_pos.position.x() + i * world_tile.w;
-                            auto direction = AABBW(world_rect, world_tile);
-                            if (direction.first != Vector2D::zero() && direction.second != Vector2D::zero())
-                            {
-                                //                                registry.ctx<collision_signal>().publish(
-                                //                                    {rect_entt, world_rect, direction},
-                                //                                    {grid_entt,
-                                //                                     world_tile,
-                                //                                     {Vector2D::zero() - direction.first,
-                                //                                     Vector2D::zero() - direction.second}});
-                                if (tile_layer.layer == LayersID::WALLS)
-                                {
-                                    if (direction.first == Vector2D::left() && rect_vel.x < 0)
-                                    {
-                                        rect_vel.x = 0;
-                                    }
-                                    else if (direction.first == Vector2D::right() && rect_vel.x > 0)
-                                    {
-
-                                        rect_vel.x = 0;
-                                    }
-                                    if (direction.second == Vector2D::up() && rect_vel.y > 0)
-                                    {
-                                        rect_vel.y = 0;
-                                    }
-                                    else if (direction.second == Vector2D::down() && rect_vel.y < 0)
-                                    {
-                                        rect_vel.y = 0;
-                                    }
-                                }
-                                //                                                                if (tile_layer.layer
-                                //                                                                == LayersID::FLOOR)
-                                //                                                                {
-                                //                                                                    auto &player =
-                                //                                                                    viewRect.get<Player>(rect_entt);
-                                //                                                                    player.i = i;
-                                //                                                                    player.j = j;
-                                //                                                                }
-                            }
+                            rect_vel.x = 0;
                         }
+                        else if (direction.first == Vector2D::right() && rect_vel.x > 0)
+                        {
 
-                        i++;
+                            rect_vel.x = 0;
+                        }
+                        if (direction.second == Vector2D::up() && rect_vel.y > 0)
+                        {
+                            rect_vel.y = 0;
+                        }
+                        else if (direction.second == Vector2D::down() && rect_vel.y < 0)
+                        {
+                            rect_vel.y = 0;
+                        }
                     }
-                    j--;
-                }
+                });
             }
         }
     };
@@ -260,7 +244,8 @@ void OnHit(const CollisionData &lhs, const CollisionData &rhs)
                     player.health--;
                     if (player.health == 0)
                     {
-                        CloseGame();
+                        // Switches activation sets, so it waits until the phase is over.
+                        sdl::Scheduler::Defer(&CloseGame);
                     }
                     else
                     {
@@ -275,12 +260,12 @@ void SetPlayerHealth(int hp)
 {
     auto view = registry.view<Label, entt::tag<"hp"_hs>>();
     auto &label = view.get<Label>(*view.begin());
-    label.AssignTexture(textureCache.resource("hp_" + std::to_string(hp)));
+    label.text = "HP " + std::to_string(hp);
 }
 
 void SetPlayerScore(int score)
 {
     auto view = registry.view<Label, entt::tag<"score"_hs>>();
     auto &label = view.get<Label>(*view.begin());
-    label.AssignTexture(textureCache.resource(std::to_string(score)));
+    label.text = std::to_string(score);
 }
@@ -2,15 +2,24 @@
 
 #include "../core.hpp"
 
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
 void PositionDebug()
 {
+    SSECS_PROFILE_FUNCTION();
     if (Position::hasDebugDraw)
     {
         auto cameraView = registry.view<Camera>();
         auto &activeCamera = cameraView.get(*cameraView.begin());
-        auto view = registry.view<Position, Active>();
+        auto view = registry.view<Position>();
 
-        view.each([activeCamera](const auto &pos, const auto &) {
+        view.each([activeCamera](const auto entity, const auto &pos) {
+            if (!activation.Test(entity))
+            {
+                return;
+            }
             sdl::Graphics::SetDrawColor(255, 0, 0, SDL_ALPHA_OPAQUE);
 
             auto position = activeCamera.FromWorldToScreenView(pos.position);
@@ -23,55 +32,57 @@ void PositionDebug()
     }
 }
 
-void CameraUpdateDebug()
+void CameraUpdateDebug(const sdl::KeyDown &event)
 {
+    SSECS_PROFILE_FUNCTION();
     if (!CameraData::isFollowing)
     {
         auto cameraView = registry.view<Camera>();
         auto &activeCamera = cameraView.get(*cameraView.begin());
-        auto event = sdl::Events::Event();
-        if (event.key.type == SDL_KEYDOWN)
+        switch (event.keysym.sym)
         {
-            switch (event.key.keysym.sym)
-            {
-            case SDLK_UP:
-                activeCamera.position.Set(activeCamera.position.x(),
-                                          activeCamera.position.y() + activeCamera.viewRadius.y() / 10);
-                break;
-            case SDLK_DOWN:
-                activeCamera.position.Set(activeCamera.position.x(),
-                                          activeCamera.position.y() - activeCamera.viewRadius.y() / 10);
-                break;
-            case SDLK_LEFT:
-                activeCamera.position.Set(activeCamera.position.x() - activeCamera.viewRadius.x() / 10,
-                                          activeCamera.position.y());
-                break;
-            case SDLK_RIGHT:
-                activeCamera.position.Set(activeCamera.position.x() + activeCamera.viewRadius.x() / 10,
-                                          activeCamera.position.y());
-                break;
-            case SDLK_PAGEUP:
-                activeCamera.viewRadius.Set(activeCamera.viewRadius.x() + activeCamera.viewRadius.x() / 10,
-                                            activeCamera.viewRadius.y() + activeCamera.viewRadius.y() / 10);
-                break;
-            case SDLK_PAGEDOWN:
-                activeCamera.viewRadius.Set(activeCamera.viewRadius.x() - activeCamera.viewRadius.x() / 10,
-                                            activeCamera.viewRadius.y() - activeCamera.viewRadius.y() / 10);
-                break;
-            }
+        case SDLK_UP:
+            activeCamera.position.Set(activeCamera.position.x(),
+                                      activeCamera.position.y() + activeCamera.viewRadius.y() / 10);
+            break;
+        case SDLK_DOWN:
+            activeCamera.position.Set(activeCamera.position.x(),
+                                      activeCamera.position.y() - activeCamera.viewRadius.y() / 10);
+            break;
+        case SDLK_LEFT:
+            activeCamera.position.Set(activeCamera.position.x() - activeCamera.viewRadius.x() / 10,
+                                      activeCamera.position.y());
+            break;
+        case SDLK_RIGHT:
+            activeCamera.position.Set(activeCamera.position.x() + activeCamera.viewRadius.x() / 10,
+                                      activeCamera.position.y());
+            break;
+        case SDLK_PAGEUP:
+            activeCamera.viewRadius.Set(activeCamera.viewRadius.x() + activeCamera.viewRadius.x() / 10,
+                                        activeCamera.viewRadius.y() + activeCamera.viewRadius.y() / 10);
+            break;
+        case SDLK_PAGEDOWN:
+            activeCamera.viewRadius.Set(activeCamera.viewRadius.x() - activeCamera.viewRadius.x() / 10,
+                                        activeCamera.viewRadius.y() - activeCamera.viewRadius.y() / 10);
+            break;
         }
     }
 }
 
 void RectDebug()
 {
+    SSECS_PROFILE_FUNCTION();
     if (RectCollider::hasDebugDraw)
     {
         auto cameraView = registry.view<Camera>();
         auto &activeCamera = cameraView.get(*cameraView.begin());
-        auto view = registry.view<Position, RectCollider, Active>();
+        auto view = registry.view<Position, RectCollider>();
 
-        view.each([activeCamera](const auto &pos, const auto &rect, const auto &act) {
+        view.each([activeCamera](const auto entity, const auto &pos, const auto &rect) {
+            if (!activation.Test(entity))
+            {
+                return;
+            }
             sdl::Graphics::SetDrawColor(255, 0, 0, SDL_ALPHA_OPAQUE);
 
             SDL_FRect frect = {pos.position.x() + rect.rect.x, pos.position.y() + rect.rect.y, rect.rect.w,
@@ -86,14 +97,122 @@ void RectDebug()
     }
 }
 
-void DebugMode()
+void DebugMode(const sdl::KeyDown &event)
 {
-    auto state = sdl::Events::KeyboardState();
-    if (state[SDL_SCANCODE_F12])
+    SSECS_PROFILE_FUNCTION();
+    if (event.repeat)
+    {
+        return;
+    }
+    if (event.keysym.sym == SDLK_F12)
     {
         RectCollider::hasDebugDraw = !RectCollider::hasDebugDraw;
         Position::hasDebugDraw = !Position::hasDebugDraw;
         TileGrid::hasDebugDraw = !TileGrid::hasDebugDraw;
         CameraData::isFollowing = !CameraData::isFollowing;
     }
+    else if (event.keysym.sym == SDLK_F11 && Position::hasDebugDraw)
+    {
+        sdl::Profiler::DumpCsv("profile.csv");
+    }
+}
+
+void LayersDebug()
+{
+    SSECS_PROFILE_FUNCTION();
+    // Setting the title is a round trip to the window manager, so it's done once a second at most.
+    constexpr const Uint32 titlePeriod = 1000;
+    static char shown[160] = "";
+    static Uint32 updated = 0;
+
+    if (!Position::hasDebugDraw)
+    {
+        if (shown[0])
+        {
+            SDL_SetWindowTitle(sdl::Graphics::Window(), "SSECS Test");
+            shown[0] = '\0';
+        }
+        return;
+    }
+    auto now = sdl::Timer::Ticks();
+    if (shown[0] && now - updated < titlePeriod)
+    {
+        return;
+    }
+    updated = now;
+
+    auto layers = sdl::Graphics::Statistics();
+    auto frames = sdl::Instances::GetGameInstance()->GetFrameRate().Statistics();
+    char title[sizeof(shown)];
+    std::snprintf(title, sizeof(title),
+                  "SSECS Test | layers cleared: %zu composited: %zu | work: %.2f ms | frame min/avg/p99: "
+                  "%.2f/%.2f/%.2f ms",
+                  layers.cleared, layers.composited, sdl::Profiler::FrameAverage(), frames.min, frames.average,
+                  frames.p99);
+    if (std::strcmp(title, shown))
+    {
+        std::memcpy(shown, title, sizeof(shown));
+        SDL_SetWindowTitle(sdl::Graphics::Window(), title);
+    }
+}
+
+void ProfilerDebug()
+{
+    SSECS_PROFILE_FUNCTION();
+    if (!Position::hasDebugDraw)
+    {
+        return;
+    }
+    // Text is glyph quads from the atlas, bars are plain rects.
+    constexpr const int layer = 7;
+    constexpr const int left = 5;
+    constexpr const int top = 5;
+    constexpr const int rowHeight = 12;
+    constexpr const int barLeft = left + 150;
+    constexpr const int pixelsPerMs = 40;
+
+    auto count = sdl::Profiler::Zones();
+    auto scale = font23Glyphs.Height() ? static_cast<float>(rowHeight) / font23Glyphs.Height() : 0.f;
+    auto drawText = [scale](const std::string_view text, const int x, const int y) {
+        font23Glyphs.Layout(
+            text, {x, y},
+            [](const SDL_Rect &src, const SDL_Rect &dst) {
+                sdl::Graphics::PushToLayer(layer, atlas.Texture(), src, dst);
+            },
+            scale);
+    };
+
+    SDL_Rect background = {0, 0, barLeft + 16 * pixelsPerMs + left,
+                           top * 2 + static_cast<int>(count + 1) * rowHeight};
+    sdl::Graphics::SetDrawColor(0, 0, 0, 160);
+    sdl::Graphics::DrawFillRectToLayer(layer, &background);
+
+    sdl::Graphics::SetDrawColor(80, 80, 80, SDL_ALPHA_OPAQUE);
+    for (int ms = 0; ms <= 16; ms++)
+    {
+        auto x = barLeft + ms * pixelsPerMs;
+        sdl::Graphics::DrawLineToLayer(layer, x, top, x, background.h - top);
+    }
+
+    for (std::size_t zone = 0; zone < count; zone++)
+    {
+        auto y = top + static_cast<int>(zone) * rowHeight;
+
+        drawText(sdl::Profiler::Name(zone), left, y);
+
+        SDL_Rect average = {barLeft, y + 2, static_cast<int>(sdl::Profiler::Average(zone) * pixelsPerMs),
+                            rowHeight - 4};
+        SDL_Rect last = {barLeft, y + 4, static_cast<int>(sdl::Profiler::Last(zone) * pixelsPerMs), rowHeight - 8};
+        sdl::Graphics::SetDrawColor(0, 120, 255, SDL_ALPHA_OPAQUE);
+        sdl::Graphics::DrawRectToLayer(layer, &average);
+        sdl::Graphics::SetDrawColor(255, 200, 0, SDL_ALPHA_OPAQUE);
+        sdl::Graphics::DrawFillRectToLayer(layer, &last);
+    }
+
+    auto frames = sdl::Instances::GetGameInstance()->GetFrameRate().Statistics();
+    char fps[64];
+    std::snprintf(fps, sizeof(fps), "fps %.0f  frame %.2f ms  p99 %.2f ms",
+                  frames.average > 0.f ? 1000.f / frames.average : 0.f, frames.average, frames.p99);
+    drawText(fps, left, top + static_cast<int>(count) * rowHeight);
+    sdl::Graphics::ResetDrawColor();
 }
@@ -1,11 +1,15 @@
 #ifndef DEBUGSYSTEM_HPP
 #define DEBUGSYSTEM_HPP
 
+#include "../sdl/events.hpp"
+
 void PositionDebug();
 
-void CameraUpdateDebug();
+void CameraUpdateDebug(const ssecs::sdl::KeyDown &event);
 
 void RectDebug();
-void DebugMode();
+void DebugMode(const ssecs::sdl::KeyDown &event);
+void LayersDebug();
+void ProfilerDebug();
 
 #endif // DEBUGSYSTEM_HPP
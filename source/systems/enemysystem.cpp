@@ -3,27 +3,34 @@
 #include "../core.hpp"
 
 #include <queue>
+#include <random>
+
+/*! @brief Fair random 0 or 1, std::rand isn't safe to call from workers. */
+static int Coin()
+{
+    thread_local std::minstd_rand engine{std::random_device{}()};
+    return std::uniform_int_distribution{0, 1}(engine);
+}
+
 void EnemyCreate(Vector2D spawn)
 {
     auto enemy = registry.create();
     registry.assign<Enemy>(enemy);
     auto &pos = registry.assign<Position>(enemy);
-    pos.position = spawn;
+    pos.Teleport(spawn);
     auto &rect = registry.assign<RectCollider>(enemy);
     auto &sprite = registry.assign<Sprite>(enemy);
+    registry.assign<Tint>(enemy);
     auto &speed = registry.assign<MovementSpeed>(enemy);
-    [[maybe_unused]] auto &vel = registry.assign<Velocity>(enemy);
     registry.assign<Health>(enemy, 2);
     registry.assign<ParticleData>(enemy);
-    registry.assign<Active>(enemy);
     speed.speed = 150;
-    registry.assign<CollisionLayer>(enemy, LayersID::ENEMY);
 
-    sprite.texture = textureCache.resource("spritesheet");
+    sprite.texture = atlas.Texture();
 
     sprite.scale = {2, 2};
     sprite.rect = spriteSheet[spriteSheet("zombie_idle").first->second];
-    sprite.layer = 2;
+    sprite.layer = 3;
     sprite.isFliped = false;
 
     rect.rect.w = sprite.rect.w * sprite.scale.x();
@@ -34,14 +41,13 @@ void EnemyCreate(Vector2D spawn)
     auto idle = spriteSheet.GetTypeFamily("zombie_idle");
     auto run = spriteSheet.GetTypeFamily("zombie_run");
 
-    animation.data.emplace("idle", Animation{idle, 0.07f, 0, 0});
-    animation.data.emplace("run", Animation{run, 0.07f, 0, 0});
+    animation.Add("idle"_hs, Animation{idle, 0.07f, 0, 0});
+    animation.Add("run"_hs, Animation{run, 0.07f, 0, 0});
 
-    animation.current = "idle";
+    animation.Play("idle"_hs);
 
     auto view = registry.create();
     auto multiplier = registry.assign<View>(view);
-    registry.assign<Active>(view);
     registry.assign<CollisionLayer>(view, LayersID::ENEMY);
     multiplier.multiplier = 12;
     registry.assign<Position>(view);
@@ -56,10 +62,17 @@ void EnemyCreate(Vector2D spawn)
     parent.child = view;
     auto &child = registry.assign<Hierarchy>(view);
     child.parent = enemy;
+
+    // These complete the owning groups, which moves owned components, so references above go stale.
+    registry.assign<Velocity>(enemy);
+    registry.assign<CollisionLayer>(enemy, LayersID::ENEMY);
+    activation.Add(enemy, ActivationSet::GAMEPLAY);
+    activation.Add(view, ActivationSet::GAMEPLAY);
 }
 
 void UpdateView()
 {
+    SSECS_PROFILE_FUNCTION();
     auto view = registry.view<Hierarchy, Position, RectCollider, View>();
     view.each([](auto &hierarchy, auto &position, auto &rect, auto &view) {
         auto parent_pos = registry.get<Position>(hierarchy.parent);
@@ -103,8 +116,13 @@ void EnemyCharging(const CollisionData &lhs, const CollisionData &rhs)
 
 void EnemyWalking(const float dt)
 {
-    auto view = registry.view<Enemy, Velocity, MovementSpeed, Active>();
-    view.each([dt](auto &enemy, auto &vel, auto &speed, const auto &) {
+    SSECS_PROFILE_FUNCTION();
+    auto view = registry.view<Enemy, Velocity, MovementSpeed>();
+    sdl::parallel_each(threadPool, view, [dt](const auto entity, auto &enemy, auto &vel, auto &speed) {
+        if (!activation.Test(entity))
+        {
+            return;
+        }
         if (enemy.dt > enemy.time)
         {
             if (vel.x || vel.y)
@@ -114,10 +132,10 @@ void EnemyWalking(const float dt)
             }
             else
             {
-                auto result = std::rand() % 2;
+                auto result = Coin();
                 if (result)
                 {
-                    result = std::rand() % 2;
+                    result = Coin();
                     if (result)
                     {
                         vel.x = 0.5f * speed.speed;
@@ -129,7 +147,7 @@ void EnemyWalking(const float dt)
                 }
                 else
                 {
-                    result = std::rand() % 2;
+                    result = Coin();
                     if (result)
                     {
                         vel.y = 0.5f * speed.speed;
@@ -150,16 +168,21 @@ void EnemyWalking(const float dt)
 
 void HealthUpdate()
 {
-    auto view = registry.view<Enemy, Health, Active, Position>();
+    SSECS_PROFILE_FUNCTION();
+    auto view = registry.view<Enemy, Health, Position>();
 
     for (auto &entt : view)
     {
+        if (!activation.Test(entt))
+        {
+            continue;
+        }
         auto &health = view.get<Health>(entt);
 
         if (health.health <= 0)
         {
             auto &&[position, enemy] = view.get<Position, Enemy>(entt);
-            position.position = Enemy::spawns[Enemy::currentSpawn];
+            position.Teleport(Enemy::spawns[Enemy::currentSpawn]);
             Enemy::currentSpawn++;
             health.health = 2;
             if (Enemy::currentSpawn >= Enemy::MAX_SPAWNS)
@@ -6,9 +6,10 @@
 
 void PlayerMovement(const float dt)
 {
+    SSECS_PROFILE_FUNCTION();
     auto state = sdl::Events::KeyboardState();
-    auto view = registry.view<Player, Velocity, MovementSpeed, AnimationPool, Sprite, Dash, Active>();
-    if (view.begin() != view.end())
+    auto view = registry.view<Player, Velocity, MovementSpeed, AnimationPool, Sprite, Dash>();
+    if (view.begin() != view.end() && activation.Test(*view.begin()))
     {
         auto &&[vel, speed, animation, sprite, dash] =
             view.get<Velocity, MovementSpeed, AnimationPool, Sprite, Dash>(*view.begin());
@@ -17,61 +18,61 @@ void PlayerMovement(const float dt)
 
         if (state[SDL_SCANCODE_W] && state[SDL_SCANCODE_D])
         {
-            animation.current = "run";
+            animation.Play("run"_hs);
             vel.y = speed.speed * diagonal;
             vel.x = speed.speed * diagonal;
             sprite.isFliped = false;
         }
         else if (state[SDL_SCANCODE_W] && state[SDL_SCANCODE_A])
         {
-            animation.current = "run";
+            animation.Play("run"_hs);
             vel.y = speed.speed * diagonal;
             vel.x = -speed.speed * diagonal;
             sprite.isFliped = true;
         }
         else if (state[SDL_SCANCODE_S] && state[SDL_SCANCODE_A])
         {
-            animation.current = "run";
+            animation.Play("run"_hs);
             vel.y = -speed.speed * diagonal;
             vel.x = -speed.speed * diagonal;
             sprite.isFliped = true;
         }
         else if (state[SDL_SCANCODE_S] && state[SDL_SCANCODE_D])
         {
-            animation.current = "run";
+            animation.Play("run"_hs);
             vel.y = -speed.speed * diagonal;
             vel.x = speed.speed * diagonal;
             sprite.isFliped = false;
         }
         else if (state[SDL_SCANCODE_W])
         {
-            animation.current = "run";
+            animation.Play("run"_hs);
             vel.y = speed.speed;
             vel.x = 0;
         }
         else if (state[SDL_SCANCODE_S])
         {
-            animation.current = "run";
+            animation.Play("run"_hs);
             vel.y = -speed.speed;
             vel.x = 0;
         }
         else if (state[SDL_SCANCODE_A])
         {
-            animation.current = "run";
+            animation.Play("run"_hs);
             sprite.isFliped = true;
             vel.x = -speed.speed;
             vel.y = 0;
         }
         else if (state[SDL_SCANCODE_D])
         {
-            animation.current = "run";
+            animation.Play("run"_hs);
             sprite.isFliped = false;
             vel.x = speed.speed;
             vel.y = 0;
         }
         else
         {
-            animation.current = "idle";
+            animation.Play("idle"_hs);
             vel.y = 0;
             vel.x = 0;
         }
@@ -81,7 +82,7 @@ void PlayerMovement(const float dt)
             dash.dt = 0;
             auto label_view = registry.view<Label, entt::tag<"dash"_hs>>();
             auto &label = label_view.get<Label>(*label_view.begin());
-            label.AssignTexture(textureCache.resource("dash_no"));
+            label.text = "X";
         }
         if (!dash.canDashing)
         {
@@ -96,7 +97,7 @@ void PlayerMovement(const float dt)
                 dash.canDashing = true;
                 auto label_view = registry.view<Label, entt::tag<"dash"_hs>>();
                 auto &label = label_view.get<Label>(*label_view.begin());
-                label.AssignTexture(textureCache.resource("dash_ok"));
+                label.text = "D";
             }
         }
     }
@@ -104,9 +105,10 @@ void PlayerMovement(const float dt)
 
 void PlayerAttack(const float dt)
 {
+    SSECS_PROFILE_FUNCTION();
     auto state = sdl::Events::KeyboardState();
-    auto view = registry.view<Player, Hierarchy, Position, Sprite, Velocity, RectCollider, Active>();
-    if (view.begin() != view.end())
+    auto view = registry.view<Player, Hierarchy, Position, Sprite, Velocity, RectCollider>();
+    if (view.begin() != view.end() && activation.Test(*view.begin()))
     {
 
         auto &&[parent, pos, sprite, vel, player, collider] =
@@ -123,8 +125,8 @@ void PlayerAttack(const float dt)
             player.dt = 0;
 
             attack_animation.isPlaying = true;
-            attack_animation.data.at(attack_animation.current).current = 0;
-            attack_animation.data.at(attack_animation.current).time = 0;
+            attack_animation.Current().current = 0;
+            attack_animation.Current().time = 0;
             attack_sprite.isHidden = false;
             attack_sprite.isFliped = sprite.isFliped;
             player.attack_direction.Set(vel.x, vel.y);
@@ -132,8 +134,7 @@ void PlayerAttack(const float dt)
         if (player.isAttacking)
         {
             player.dt += dt;
-            if (attack_animation.data.at(attack_animation.current).current ==
-                attack_animation.data.at(attack_animation.current).data.size())
+            if (attack_animation.Current().current == attack_animation.Current().data.size())
             {
                 attack_sprite.isHidden = true;
                 attack_animation.isPlaying = false;
@@ -183,71 +184,30 @@ void PlayerAttack(const float dt)
 
 void ActiveGame()
 {
-    auto enemyView = registry.view<Enemy, Hierarchy, Health>();
-    for (auto &entt : enemyView)
-    {
-        registry.assign<Active>(entt);
-        auto &hierarchy = enemyView.get<Hierarchy>(entt);
-        if (hierarchy.child != entt::null)
-        {
-            registry.assign<Active>(hierarchy.child);
-        }
-    }
-    auto playerView = registry.view<Player, Hierarchy, Position, Health>();
-    auto &&[player, hierarchy, health, pos] = registry.get<Player, Hierarchy, Health, Position>(*playerView.begin());
-    registry.assign<Active>(*playerView.begin());
-    if (hierarchy.child != entt::null)
-    {
-        registry.assign<Active>(hierarchy.child);
-    }
+    auto playerView = registry.view<Player, Position, Health>();
+    auto &&[player, health, pos] = registry.get<Player, Health, Position>(*playerView.begin());
     health.health = 3;
     player.score = 0;
-    pos.position = {550, 746};
+    pos.Teleport({550, 746});
     SetPlayerScore(0);
     SetPlayerHealth(3);
 
-    auto score = registry.view<entt::tag<"score"_hs>>();
-    registry.assign<Active>(*score.begin());
-    auto hp = registry.view<entt::tag<"hp"_hs>>();
-    registry.assign<Active>(*hp.begin());
-    auto dash = registry.view<entt::tag<"dash"_hs>>();
-    registry.assign<Active>(*dash.begin());
-
-    auto table_view = registry.view<entt::tag<"table"_hs>>();
-    for (auto &entt : table_view)
-    {
-        registry.remove<Active>(entt);
-    }
+    activation.Disable(ActivationSet::MENU);
+    activation.Enable(ActivationSet::GAMEPLAY);
 }
 void CloseGame()
 {
-    auto enemyView = registry.view<Enemy, Hierarchy, Health>();
+    auto enemyView = registry.view<Enemy, Health>();
     for (auto &entt : enemyView)
     {
-        registry.remove<Active>(entt);
-        auto &hierarchy = enemyView.get<Hierarchy>(entt);
-        if (hierarchy.child != entt::null)
-        {
-            registry.remove<Active>(hierarchy.child);
-        }
         auto &health = enemyView.get<Health>(entt);
         health.health = 0;
     }
-    auto playerView = registry.view<Player, Hierarchy>();
-    auto &&[player, hierarchy] = registry.get<Player, Hierarchy>(*playerView.begin());
-    registry.remove<Active>(*playerView.begin());
-    if (hierarchy.child != entt::null)
-    {
-        registry.remove<Active>(hierarchy.child);
-    }
-
-    auto score = registry.view<entt::tag<"score"_hs>>();
-    registry.remove<Active>(*score.begin());
-    auto hp = registry.view<entt::tag<"hp"_hs>>();
-    registry.remove<Active>(*hp.begin());
-    auto dash = registry.view<entt::tag<"dash"_hs>>();
-    registry.remove<Active>(*dash.begin());
+    activation.Disable(ActivationSet::GAMEPLAY);
+    activation.Enable(ActivationSet::MENU);
 
+    auto playerView = registry.view<Player>();
+    auto &player = playerView.get(*playerView.begin());
     for (auto &row : scoreTable.table)
     {
         if (row.second < player.score)
@@ -257,45 +217,35 @@ void CloseGame()
             break;
         }
     }
-    auto table_view = registry.view<entt::tag<"table"_hs>>();
-    for (auto &entt : table_view)
-    {
-
-        registry.assign<Active>(entt);
-    }
     ResetTable();
     isMenu = true;
 }
 
-void OpenGame()
+void OpenGame(const sdl::KeyDown &event)
 {
-    if (isMenu)
+    SSECS_PROFILE_FUNCTION();
+    if (isMenu && !event.repeat)
     {
-        auto state = sdl::Events::KeyboardState();
-        auto event = sdl::Events::Event();
         auto view = registry.view<Player>();
         auto &player = view.get<Player>(*view.begin());
-        if (event.type == SDL_KEYDOWN && event.key.repeat == 0)
+        if (event.keysym.sym >= SDLK_a && event.keysym.sym <= SDLK_z)
         {
-            if (event.key.keysym.sym >= SDLK_a && event.key.keysym.sym <= SDLK_z)
+            if (player.name.size() < 3)
             {
-                if (player.name.size() < 3)
-                {
-                    player.name += event.key.keysym.sym;
+                player.name += event.keysym.sym;
 
-                    ResetName();
-                }
+                ResetName();
             }
-            if (event.key.keysym.sym == SDLK_BACKSPACE)
+        }
+        if (event.keysym.sym == SDLK_BACKSPACE)
+        {
+            if (player.name.size() > 0)
             {
-                if (player.name.size() > 0)
-                {
-                    player.name.pop_back();
-                    ResetName();
-                }
+                player.name.pop_back();
+                ResetName();
             }
         }
-        if (state[SDL_SCANCODE_RETURN])
+        if (event.keysym.sym == SDLK_RETURN)
         {
             isMenu = false;
             ActiveGame();
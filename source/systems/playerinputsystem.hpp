@@ -1,10 +1,12 @@
 #ifndef PLAYERINPUTSYSTEM_HPP
 #define PLAYERINPUTSYSTEM_HPP
 
+#include "../sdl/events.hpp"
+
 void PlayerMovement(const float dt);
 void PlayerAttack(const float dt);
 void ActiveGame();
 void CloseGame();
-void OpenGame();
+void OpenGame(const ssecs::sdl::KeyDown &event);
 
 #endif // PLAYERINPUTSYSTEM_HPP
@@ -2,13 +2,55 @@
 
 #include "../core.hpp"
 
+/*! @brief Integration is a few instructions per entity, so jobs take large chunks. */
+static constexpr const std::size_t movement_grain = 4096;
+
+void PartitionMovement()
+{
+    SSECS_PROFILE_FUNCTION();
+    auto group = MovementGroup();
+    auto &batch = registry.ctx<MovementBatch>();
+    if (batch.sorted && batch.size == group.size() && batch.version == activation.Version())
+    {
+        return;
+    }
+    // Group iterates raw arrays backwards, so disabled first puts enabled ones at the front.
+    group.sort([](const entt::entity lhs, const entt::entity rhs) {
+        return !activation.Test(lhs) && activation.Test(rhs);
+    });
+    const auto *entities = group.data();
+    batch.enabled = 0;
+    while (batch.enabled < group.size() && activation.Test(entities[batch.enabled]))
+    {
+        batch.enabled++;
+    }
+    batch.size = group.size();
+    batch.version = activation.Version();
+    batch.sorted = true;
+}
+
 void MovementUpdate(float dt)
 {
-    auto view = registry.view<Position, Velocity, Active>();
+    SSECS_PROFILE_FUNCTION();
+    auto group = MovementGroup();
+    const auto &batch = registry.ctx<MovementBatch>();
+    SSECS_ASSERT(batch.sorted && batch.size == group.size() && batch.version == activation.Version());
+
+    auto *positions = group.raw<Position>();
+    const auto *velocities = group.raw<Velocity>();
+    threadPool.ParallelFor(batch.enabled, movement_grain, [=](const std::size_t begin, const std::size_t end) {
+        Integrate(positions + begin, velocities + begin, end - begin, dt);
+    });
+}
+
+void PositionSnapshot()
+{
+    SSECS_PROFILE_FUNCTION();
+    auto view = registry.view<Position>();
 
     for (auto &entity : view)
     {
-        auto &&[pos, vel] = view.get<Position, Velocity>(entity);
-        pos.position.Set(pos.position.x() + vel.x * dt, pos.position.y() + vel.y * dt);
+        auto &pos = view.get(entity);
+        pos.previous = pos.position;
     }
 }
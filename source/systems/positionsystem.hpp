@@ -1,6 +1,8 @@
 #ifndef POSITIONSYSTEM_HPP
 #define POSITIONSYSTEM_HPP
 
+void PartitionMovement();
 void MovementUpdate(float dt);
+void PositionSnapshot();
 
 #endif // POSITIONSYSTEM_HPP
@@ -2,31 +2,33 @@
 
 #include "../core.hpp"
 
-void SpriteRender()
+void SpriteRender(const float alpha)
 {
-    auto view = registry.view<Sprite, Position, Active>();
+    SSECS_PROFILE_FUNCTION();
+    auto view = registry.view<Sprite, Tint, Position>();
     auto cameraView = registry.view<Camera>();
     auto camera = cameraView.get(*cameraView.begin());
 
     for (const auto &entity : view)
     {
+        if (!activation.Test(entity))
+        {
+            continue;
+        }
         Sprite sprite = view.get<Sprite>(entity);
         if (!sprite.isHidden)
         {
-            Position position = view.get<Position>(entity);
+            auto position = view.get<Position>(entity).Interpolated(alpha);
 
-            SDL_FRect rect{position.position.x(), position.position.y(), sprite.rect.w * sprite.scale.x(),
+            SDL_FRect rect{position.x(), position.y(), sprite.rect.w * sprite.scale.x(),
                            sprite.rect.h * sprite.scale.y()};
 
             if (camera.Contains(rect))
             {
                 SDL_Rect dst_rect = camera.FromWorldToScreenRect(rect);
-                SDL_SetTextureAlphaMod(sprite.texture, sprite.color.a);
-
-                sdl::Graphics::RenderToLayer(sprite.layer, sprite.texture, &sprite.rect, &dst_rect,
-                                             (sprite.isFliped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE));
-
-                SDL_SetTextureAlphaMod(sprite.texture, SDL_ALPHA_OPAQUE);
+                sdl::Graphics::PushToLayer(sprite.layer, sprite.texture, sprite.rect, dst_rect,
+                                           (sprite.isFliped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE),
+                                           view.get<Tint>(entity).color.a);
             }
         }
     };
@@ -36,35 +38,33 @@ void PlayerCreate()
 {
     auto id = registry.create();
     auto &sprite = registry.assign<Sprite>(id);
+    registry.assign<Tint>(id);
     auto &pos = registry.assign<Position>(id);
-    registry.assign<Velocity>(id);
     auto &animation = registry.assign<AnimationPool>(id);
     registry.assign<Player>(id);
     registry.assign<Health>(id, 3);
-    registry.assign<Active>(id);
     auto &speed = registry.assign<MovementSpeed>(id);
     auto &rect = registry.assign<RectCollider>(id);
 
     registry.assign<NullVelocityCollision>(id);
-    registry.assign<CollisionLayer>(id, LayersID::PLAYER);
     registry.assign<ParticleData>(id);
     registry.assign<Dash>(id);
 
     auto idle = spriteSheet.GetTypeFamily("knight_idle");
     auto run = spriteSheet.GetTypeFamily("knight_run");
 
-    animation.data.emplace("idle", Animation{idle, 0.07f, 0, 0});
-    animation.data.emplace("run", Animation{run, 0.07f, 0, 0});
-    animation.current = "idle";
+    animation.Add("idle"_hs, Animation{idle, 0.07f, 0, 0});
+    animation.Add("run"_hs, Animation{run, 0.07f, 0, 0});
+    animation.Play("idle"_hs);
     animation.isPlaying = true;
 
-    pos.position = {550, 746};
+    pos.Teleport({550, 746});
 
-    sprite.texture = textureCache.resource("spritesheet");
+    sprite.texture = atlas.Texture();
 
     sprite.scale = {2, 2};
     sprite.rect = spriteSheet[spriteSheet("knight_idle").first->second];
-    sprite.layer = 2;
+    sprite.layer = 3;
     sprite.isFliped = false;
 
     rect.rect.w = sprite.rect.w * sprite.scale.x();
@@ -76,9 +76,6 @@ void PlayerCreate()
     [[maybe_unused]] auto &attack_pos = registry.assign<Position>(attack);
     auto &attack_rect = registry.assign<RectCollider>(attack);
     auto &attack_animation = registry.assign<AnimationPool>(attack);
-    registry.assign<Active>(attack);
-
-    registry.assign<CollisionLayer>(attack, LayersID::PLAYER);
 
     auto &attack_hierarchy = registry.assign<Hierarchy>(attack);
     attack_hierarchy.parent = id;
@@ -86,11 +83,12 @@ void PlayerCreate()
     parent.child = attack;
 
     auto &attack_sprite = registry.assign<Sprite>(attack);
-    attack_sprite.texture = textureCache.resource("spritesheet");
+    registry.assign<Tint>(attack);
+    attack_sprite.texture = atlas.Texture();
 
     attack_sprite.scale = {2, 2};
     attack_sprite.rect = spriteSheet[spriteSheet("attack").first->second];
-    attack_sprite.layer = 2;
+    attack_sprite.layer = 3;
     attack_sprite.isFliped = false;
     attack_sprite.isHidden = true;
 
@@ -99,24 +97,30 @@ void PlayerCreate()
 
     auto animation_type = spriteSheet.GetTypeFamily("attack");
 
-    attack_animation.data.emplace("attack", Animation{animation_type, 0.05f, 0, 0});
+    attack_animation.Add("attack"_hs, Animation{animation_type, 0.05f, 0, 0});
 
-    attack_animation.current = "attack";
+    attack_animation.Play("attack"_hs);
     attack_animation.isPlaying = false;
+
+    // These complete the owning groups, which moves owned components, so references above go stale.
+    registry.assign<Velocity>(id);
+    registry.assign<CollisionLayer>(id, LayersID::PLAYER);
+    registry.assign<CollisionLayer>(attack, LayersID::PLAYER);
+    activation.Add(id, ActivationSet::GAMEPLAY);
+    activation.Add(attack, ActivationSet::GAMEPLAY);
 }
 
 void AnimationUpdate(const float dt)
 {
-    auto view = registry.view<Sprite, Position, AnimationPool, Active>();
-    auto cameraView = registry.view<Camera>();
-    auto camera = cameraView.get(*cameraView.begin());
+    SSECS_PROFILE_FUNCTION();
+    auto view = registry.view<Sprite, AnimationPool>();
 
-    for (auto &entity : view)
-    {
-
-        auto &animationPool = view.get<AnimationPool>(entity);
-        auto &animation = animationPool.data.at(animationPool.current);
-        auto &sprite = view.get<Sprite>(entity);
+    sdl::parallel_each(threadPool, view, [dt](const auto entity, auto &sprite, auto &animationPool) {
+        if (!activation.Test(entity))
+        {
+            return;
+        }
+        auto &animation = animationPool.Current();
         if (animation.current >= animation.data.size())
         {
             animation.current = 0;
@@ -128,13 +132,18 @@ void AnimationUpdate(const float dt)
             animation.time = 0;
             animation.current++;
         }
-    }
+    });
 }
 void ParticleUpdate(const float dt)
 {
-    auto view = registry.view<ParticleData, Sprite, Active>();
+    SSECS_PROFILE_FUNCTION();
+    auto view = registry.view<ParticleData, Tint>();
 
-    view.each([dt](auto &particle, auto &sprite, const auto &) {
+    sdl::parallel_each(threadPool, view, [dt](const auto entity, auto &particle, auto &tint) {
+        if (!activation.Test(entity))
+        {
+            return;
+        }
         if (particle.isPlaying)
         {
             particle.dt += dt;
@@ -142,20 +151,20 @@ void ParticleUpdate(const float dt)
             {
                 particle.isPlaying = false;
                 particle.dt = 0;
-                sprite.color.a = SDL_ALPHA_OPAQUE;
+                tint.color.a = SDL_ALPHA_OPAQUE;
             }
             else
             {
-                if (sprite.color.a >= SDL_ALPHA_OPAQUE && !particle.isTranspereting)
+                if (tint.color.a >= SDL_ALPHA_OPAQUE && !particle.isTranspereting)
                 {
                     particle.isTranspereting = !particle.isTranspereting;
                 }
-                else if (sprite.color.a <= 20 && particle.isTranspereting)
+                else if (tint.color.a <= 20 && particle.isTranspereting)
                 {
                     particle.isTranspereting = !particle.isTranspereting;
                 }
-                sprite.color.a += (particle.isTranspereting ? -particle.step : particle.step);
-                sprite.color.r = 255;
+                tint.color.a += (particle.isTranspereting ? -particle.step : particle.step);
+                tint.color.r = 255;
             }
         }
     });
@@ -163,17 +172,30 @@ void ParticleUpdate(const float dt)
 
 void LabelsRender()
 {
-    auto view = registry.view<Label, Active>();
+    SSECS_PROFILE_FUNCTION();
+    auto view = registry.view<Label>();
     auto cameraView = registry.view<Camera>();
     auto camera = cameraView.get(*cameraView.begin());
 
     for (auto &entt : view)
     {
+        if (!activation.Test(entt))
+        {
+            continue;
+        }
         auto &label = view.get<Label>(entt);
+        if (!label.glyphs || label.text.empty())
+        {
+            continue;
+        }
+        label.dst_rect.w = label.glyphs->Measure(label.text);
+        label.dst_rect.h = label.glyphs->Height();
         if (camera.Contains(label.dst_rect))
         {
-            SDL_SetTextureAlphaMod(label.texture, 255);
-            sdl::Graphics::RenderToLayer(6, label.texture, &label.src_rect, &label.dst_rect);
+            label.glyphs->Layout(label.text, {label.dst_rect.x, label.dst_rect.y},
+                                 [](const SDL_Rect &src, const SDL_Rect &dst) {
+                                     sdl::Graphics::PushToLayer(6, atlas.Texture(), src, dst);
+                                 });
         }
     };
 }
@@ -184,60 +206,43 @@ void CreateLabels()
         auto id = registry.create();
         registry.assign<entt::tag<"dash"_hs>>(id);
         auto &label = registry.assign<Label>(id);
-        registry.assign<Active>(id);
+        activation.Add(id, ActivationSet::GAMEPLAY);
 
-        textureCache.load("dash_ok",
-                          sdl::ResourceLoader::Text(fontCache.resource("font23"), "D", {255, 255, 255, 255}));
-        textureCache.load("dash_no",
-                          sdl::ResourceLoader::Text(fontCache.resource("font23"), "X", {255, 255, 255, 255}));
-        label.texture = textureCache.resource("dash_ok");
+        label.glyphs = &font23Glyphs;
+        label.text = "D";
         label.dst_rect.x = 580;
         label.dst_rect.y = 580;
-
-        label.AssignTexture(textureCache.resource("dash_ok"));
     }
     {
         auto id = registry.create();
         registry.assign<entt::tag<"hp"_hs>>(id);
         auto &label = registry.assign<Label>(id);
-        registry.assign<Active>(id);
-
-        textureCache.load("hp_3",
-                          sdl::ResourceLoader::Text(fontCache.resource("font35"), "HP 3", {255, 255, 255, 255}));
-        textureCache.load("hp_2",
-                          sdl::ResourceLoader::Text(fontCache.resource("font35"), "HP 2", {255, 255, 255, 255}));
-        textureCache.load("hp_1",
-                          sdl::ResourceLoader::Text(fontCache.resource("font35"), "HP 1", {255, 255, 255, 255}));
-        label.texture = textureCache.resource("hp_3");
+        activation.Add(id, ActivationSet::GAMEPLAY);
+
+        label.glyphs = &font35Glyphs;
+        label.text = "HP 3";
         label.dst_rect.x = 540;
         label.dst_rect.y = 0;
-
-        label.AssignTexture(textureCache.resource("hp_3"));
     }
     {
         auto id = registry.create();
         registry.assign<entt::tag<"score"_hs>>(id);
         auto &label = registry.assign<Label>(id);
-        registry.assign<Active>(id);
-
-        for (int i = 0; i < 100; i++)
-        {
-            textureCache.load(std::to_string(i), sdl::ResourceLoader::Text(fontCache.resource("font35"),
-                                                                           std::to_string(i), {255, 255, 255, 255}));
-        }
+        activation.Add(id, ActivationSet::GAMEPLAY);
 
-        label.texture = textureCache.resource("0");
+        label.glyphs = &font35Glyphs;
+        label.text = "0";
         label.dst_rect.x = 0;
         label.dst_rect.y = 0;
-
-        label.AssignTexture(textureCache.resource("0"));
     }
     for (int i = 0; i < ScoreTable::TABLE_SIZE; i++)
     {
         auto id = registry.create();
         registry.assign<entt::tag<"table"_hs>>(id);
         auto &label = registry.assign<Label>(id);
+        activation.Add(id, ActivationSet::MENU);
 
+        label.glyphs = &font35Glyphs;
         label.dst_rect.x = 100;
         label.dst_rect.y = 100 * (i + 1);
     }
@@ -245,14 +250,12 @@ void CreateLabels()
         auto id = registry.create();
         registry.assign<entt::tag<"name"_hs>>(id);
         auto &label = registry.assign<Label>(id);
-        registry.assign<Active>(id);
+        activation.Add(id, ActivationSet::ALWAYS);
 
         auto view = registry.view<Player>();
         auto &player = view.get<Player>(*view.begin());
-        textureCache.load("name",
-                          sdl::ResourceLoader::Text(fontCache.resource("font23"), player.name, {255, 255, 255, 255}));
-
-        label.AssignTexture(textureCache.resource("name"));
+        label.glyphs = &font23Glyphs;
+        label.text = player.name;
         label.dst_rect.x = 0;
         label.dst_rect.y = 580;
     }
@@ -265,18 +268,14 @@ void ResetTable()
     for (auto &entt : view)
     {
         auto &label = view.get<Label>(entt);
-        std::string text;
         if (scoreTable.table[i].second > 0)
         {
-            text = scoreTable.table[i].first + "   " + std::to_string(scoreTable.table[i].second);
+            label.text = scoreTable.table[i].first + "   " + std::to_string(scoreTable.table[i].second);
         }
         else
         {
-            text = " ";
+            label.text.clear();
         }
-        textureCache.load("table" + std::to_string(i),
-                          sdl::ResourceLoader::Text(fontCache.resource("font35"), text, {255, 255, 255, 255}));
-        label.AssignTexture(textureCache.resource("table" + std::to_string(i)));
         i--;
     }
 }
@@ -289,11 +288,6 @@ void ResetName()
     auto view_player = registry.view<Player>();
     for (auto &entt : view_player)
     {
-        auto &player = view_player.get<Player>(entt);
-        textureCache.load("name",
-                          sdl::ResourceLoader::Text(fontCache.resource("font23"),
-                                                    (player.name.empty() ? " " : player.name), {255, 255, 255, 255}));
-
-        label.AssignTexture(textureCache.resource("name"));
+        label.text = view_player.get<Player>(entt).name;
     }
 }
@@ -3,7 +3,7 @@
 
 #include <string>
 void PlayerCreate();
-void SpriteRender();
+void SpriteRender(const float alpha);
 void ParticleUpdate(const float dt);
 void AnimationUpdate(const float dt);
 void LabelsRender();
@@ -1,89 +1,201 @@
 #include "tilegridsystem.hpp"
 
 #include "../core.hpp"
+#include "../resource/mapped_file.hpp"
+
+static void BakeChunk(const TileGrid &grid, TileGridCache::Chunk &chunk, const int x, const int y)
+{
+    auto left = x * TileGrid::chunk_size;
+    auto bottom = y * TileGrid::chunk_size;
+    auto cols = std::min(TileGrid::chunk_size, grid.Width() - left);
+    auto rows = std::min(TileGrid::chunk_size, grid.Height() - bottom);
+    chunk.revision = grid.Revision(x, y);
+
+    bool isEmpty = true;
+    for (int j = bottom; j < bottom + rows && isEmpty; j++)
+    {
+        grid.EachSolid(j, left, left + cols - 1, [&isEmpty](const int) { isEmpty = false; });
+    }
+    if (isEmpty)
+    {
+        if (chunk.texture)
+        {
+            SDL_DestroyTexture(chunk.texture);
+            chunk.texture = nullptr;
+        }
+        return;
+    }
+
+    auto texture = grid.tileSet->Texture();
+    auto tileWidth = grid.tileSet->TileWidth();
+    auto tileHeight = grid.tileSet->TileHeight();
+    if (!chunk.texture)
+    {
+        chunk.texture = sdl::Graphics::CreateTarget(TileGrid::chunk_size * tileWidth, TileGrid::chunk_size * tileHeight);
+    }
+    sdl::Graphics::ClearTarget(chunk.texture);
+
+    // Tiles of a chunk never overlap, so they are copied as is, alpha included.
+    SDL_BlendMode mode;
+    SDL_GetTextureBlendMode(texture, &mode);
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+    for (int r = 0; r < rows; r++)
+    {
+        auto row = grid.Row(bottom + r);
+        SDL_Rect dst{0, (rows - 1 - r) * tileHeight, tileWidth, tileHeight};
+        for (int c = 0; c < cols; c++)
+        {
+            if (auto id = row[left + c])
+            {
+                dst.x = c * tileWidth;
+                sdl::Graphics::RenderToTarget(chunk.texture, texture, &(*grid.tileSet)[id - 1], &dst);
+            }
+        }
+    }
+    SDL_SetTextureBlendMode(texture, mode);
+}
 
 void GridRender()
 {
-    auto gridView = registry.view<TileGrid, Position>();
+    SSECS_PROFILE_FUNCTION();
+    auto gridView = registry.view<TileGrid, TileGridCache, Position>();
     auto cameraView = registry.view<Camera>();
     auto &activeCamera = cameraView.get(*cameraView.begin());
 
     activeCamera.UpdateWindowSize(sdl::Graphics::Window());
-    gridView.each([activeCamera](const auto &grid, const auto &position) {
-        SDL_FRect world_tile{position.position.x(), position.position.y(), grid.tileSet->TileWidth() * grid.scale.x(),
-                             grid.tileSet->TileHeight() * grid.scale.y()};
-        auto screenRect = activeCamera.FromWorldToScreenRect(world_tile);
-        SDL_Rect screenPosition = {screenRect.x, screenRect.y};
-
-        int j = grid.cell.size() - 1;
-        for (const auto &row : grid.cell)
+    gridView.each([activeCamera](const auto &grid, auto &cache, const auto &position) {
+        auto size = grid.CellSize();
+        cache.Resize(grid.ChunksX(), grid.ChunksY());
+
+        // Grid layers are static, they are drawn again only when view or cells change.
+        auto view = activeCamera.WorldRect();
+        if (!TileGrid::hasDebugDraw && sdl::Graphics::LayerHasContent(grid.layer) &&
+            cache.Unchanged(view, grid.Revision()))
         {
-            int i = 0;
-            screenRect.y = static_cast<int>(screenPosition.y - screenRect.h * j);
-            for (const auto &id : row)
+            return;
+        }
+        sdl::Graphics::InvalidateLayer(grid.layer);
+        cache.Remember(view, grid.Revision());
+
+        auto visible = grid.Cover(position.position, view);
+        if (visible.Empty())
+        {
+            return;
+        }
+        for (int y = visible.bottom / TileGrid::chunk_size; y <= visible.top / TileGrid::chunk_size; y++)
+        {
+            for (int x = visible.left / TileGrid::chunk_size; x <= visible.right / TileGrid::chunk_size; x++)
             {
-                if (id)
+                auto left = x * TileGrid::chunk_size;
+                auto bottom = y * TileGrid::chunk_size;
+                auto cols = std::min(TileGrid::chunk_size, grid.Width() - left);
+                auto rows = std::min(TileGrid::chunk_size, grid.Height() - bottom);
+
+                SDL_FRect world_chunk{position.position.x() + left * size.x(), position.position.y() + bottom * size.y(),
+                                      cols * size.x(), rows * size.y()};
+
+                auto &chunk = cache.At(x, y);
+                if (chunk.revision != grid.Revision(x, y))
+                {
+                    BakeChunk(grid, chunk, x, y);
+                }
+                if (!chunk.texture)
                 {
+                    continue;
+                }
+
+                SDL_Rect src{0, 0, cols * grid.tileSet->TileWidth(), rows * grid.tileSet->TileHeight()};
+                auto screenRect = activeCamera.FromWorldToScreenRect(world_chunk);
+                sdl::Graphics::PushToLayer(grid.layer, chunk.texture, src, screenRect);
 
-                    screenRect.x = static_cast<int>(screenPosition.x + screenRect.w * i);
-                    if (activeCamera.Contains(screenRect))
+                if (TileGrid::hasDebugDraw)
+                {
+                    sdl::Graphics::SetDrawColor(0, 0, 255, 255);
+                    auto first = std::max(left, visible.left);
+                    auto last = std::min(left + cols - 1, visible.right);
+                    for (int j = std::max(bottom, visible.bottom); j <= std::min(bottom + rows - 1, visible.top); j++)
                     {
-                        sdl::Graphics::RenderToLayer(grid.layer, grid.tileSet->Texture(), &(*grid.tileSet)[id - 1],
-                                                     &screenRect);
-                        if (TileGrid::hasDebugDraw)
-                        {
-                            sdl::Graphics::SetDrawColor(0, 0, 255, 255);
-                            sdl::Graphics::DrawRectToLayer(6, &screenRect);
-                            sdl::Graphics::ResetDrawColor();
-                        }
+                        grid.EachSolid(j, first, last, [&](const int i) {
+                            SDL_FRect world_tile{position.position.x() + i * size.x(),
+                                                 position.position.y() + j * size.y(), size.x(), size.y()};
+                            auto tileRect = activeCamera.FromWorldToScreenRect(world_tile);
+                            sdl::Graphics::DrawRectToLayer(6, &tileRect);
+                        });
                     }
-
-                    //                    }
+                    sdl::Graphics::ResetDrawColor();
                 }
-                i++;
             }
-            j--;
         }
     });
 }
 
-void GridCreate()
+std::vector<TileGrid> GridLoad(const bool compiled)
 {
+    // Precompiled map is mapped straight into memory, tmx stays as a fallback
+    // and wins when the map was compiled from another version of it.
+    resource::mapped_file file;
+    resource::mapped_file source;
+    resource::map_view view;
+    bool hasCompiled = compiled && file.open(compiled_map) && view.open(file.data(), file.size()) &&
+                       view.header().id_size == sizeof(TileGrid::id_type) && source.open(tmx_map) &&
+                       view.built_from(source.data(), source.size());
+
     pugi::xml_document map;
-    auto result = map.load_file("resources/tiled_files/map_test.tmx");
-    if (!result)
+    if (!hasCompiled)
     {
-        FAST_THROW(result.description());
+        auto result = map.load_file(tmx_map);
+        if (!result)
+        {
+            FAST_THROW(result.description());
+        }
     }
+
+    std::vector<TileGrid> grids;
+    for (TileGrid::size_type layer = 1; layer <= 3; layer++)
     {
-        auto id = registry.create();
-        auto &tilegrid = registry.assign<TileGrid>(id, map, &tileset, 1);
-        registry.assign<Position>(id);
-        registry.assign<TileGridCollider>(id);
-        registry.assign<CollisionLayer>(id, LayersID::FLOOR);
-        registry.assign<Active>(id);
+        auto &tilegrid = hasCompiled ? grids.emplace_back(view, &tileset, layer)
+                                     : grids.emplace_back(map, &tileset, layer);
         tilegrid.scale = {2, 2};
-        tilegrid.layer = 0;
+        tilegrid.layer = static_cast<int>(layer) - 1;
     }
+    return grids;
+}
+
+void GridCreate()
+{
+    for (auto &grid : GridLoad())
     {
         auto id = registry.create();
-        auto &tilegrid = registry.assign<TileGrid>(id, map, &tileset, 2);
+        auto &tilegrid = registry.assign<TileGrid>(id, std::move(grid));
         registry.assign<Position>(id);
+        registry.assign<TileGridCache>(id);
         registry.assign<TileGridCollider>(id);
-        registry.assign<CollisionLayer>(id, LayersID::WALLS);
-        registry.assign<Active>(id);
-        tilegrid.scale = {2, 2};
-        tilegrid.layer = 1;
+        registry.assign<CollisionLayer>(id, tilegrid.layer == 0 ? LayersID::FLOOR : LayersID::WALLS);
+        activation.Add(id, ActivationSet::ALWAYS);
+        sdl::Graphics::SetLayerStatic(tilegrid.layer);
     }
+}
+
+void GridReload(std::vector<TileGrid> grids)
+{
+    auto view = registry.view<TileGrid, TileGridCache>();
+    for (auto entity : view)
     {
-        auto id = registry.create();
-        auto &tilegrid = registry.assign<TileGrid>(id, map, &tileset, 3);
-        registry.assign<Position>(id);
-        registry.assign<TileGridCollider>(id);
-        registry.assign<CollisionLayer>(id, LayersID::WALLS);
-        registry.assign<Active>(id);
+        auto layer = view.get<TileGrid>(entity).layer;
+        auto grid = std::find_if(grids.begin(), grids.end(), [layer](const auto &grid) { return grid.layer == layer; });
+        if (grid != grids.end())
+        {
+            registry.replace<TileGrid>(entity, std::move(*grid));
+            view.get<TileGridCache>(entity).Reset();
+        }
+    }
+}
 
-        tilegrid.scale = {2, 2};
-        tilegrid.layer = 2;
+void GridRefresh()
+{
+    auto view = registry.view<TileGridCache>();
+    for (auto entity : view)
+    {
+        view.get(entity).Reset();
     }
 }
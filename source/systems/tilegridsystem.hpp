@@ -1,6 +1,23 @@
 #ifndef TILEGRIDSYSTEM_HPP
 #define TILEGRIDSYSTEM_HPP
 
+#include <vector>
+
+#include "../component/tilegrid.hpp"
+
+/*! @brief Precompiled map, GridLoad reads tmx_map if it's missing. */
+constexpr const char *compiled_map = "resources/tiled_files/map_test.ssmap";
+constexpr const char *tmx_map = "resources/tiled_files/map_test.tmx";
+
+/**
+ * @brief Read grids of the map, doesn't touch the registry, so it may run on the loader thread.
+ * @param compiled False to parse tmx_map even if compiled_map is up to date with it.
+ */
+std::vector<ssecs::component::TileGrid> GridLoad(bool compiled = true);
 void GridCreate();
+/*! @brief Replace grids of entities by render layer, entities and their other components stay. */
+void GridReload(std::vector<ssecs::component::TileGrid> grids);
+/*! @brief Drop baked chunks, so they are drawn again from the tile set. */
+void GridRefresh();
 void GridRender();
 #endif
@@ -0,0 +1,175 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../entt/entity/registry.hpp"
+#include "../component/activation.hpp"
+#include "../component/colliders.hpp"
+#include "../component/transform.hpp"
+
+using namespace ssecs::component;
+
+namespace
+{
+constexpr const int repeats = 100;
+
+/*! @brief Tag the game used to toggle entities before Activation. */
+struct Tagged
+{
+};
+
+/**
+ * @brief Fill registry with a mix close to the game one: movers, static colliders,
+ * decor without colliders, and a last quarter of disabled entities created for another set.
+ */
+void Populate(entt::registry &registry, Activation &activation, const int count)
+{
+    for (int index = 0; index < count; index++)
+    {
+        auto id = registry.create();
+        registry.assign<Position>(id).Teleport({static_cast<float>(index), 0.f});
+        switch (index < count / 4 * 3 ? index % 3 : 3)
+        {
+        case 0: // Mover with collider, like enemies and the player.
+            registry.assign<Velocity>(id, 1.f, 1.f);
+            registry.assign<RectCollider>(id);
+            registry.assign<CollisionLayer>(id, LayersID::ENEMY);
+            activation.Add(id, ActivationSet::GAMEPLAY);
+            break;
+        case 1: // Static collider, like enemy views and attacks.
+            registry.assign<RectCollider>(id);
+            registry.assign<CollisionLayer>(id, LayersID::PLAYER);
+            activation.Add(id, ActivationSet::GAMEPLAY);
+            break;
+        case 2: // Decor.
+            activation.Add(id, ActivationSet::ALWAYS);
+            break;
+        default: // Inactive mover.
+            registry.assign<Velocity>(id, 1.f, 1.f);
+            registry.assign<RectCollider>(id);
+            registry.assign<CollisionLayer>(id, LayersID::ENEMY);
+            activation.Add(id, ActivationSet::MENU);
+            break;
+        }
+    }
+}
+
+/*! @brief Returns average nanoseconds per entity of the whole registry for one pass. */
+template <typename Func>
+double Measure(const int count, Func func)
+{
+    func(); // Warm up caches.
+    auto start = std::chrono::steady_clock::now();
+    for (int index = 0; index < repeats; index++)
+    {
+        func();
+    }
+    std::chrono::duration<double, std::nano> ellapsed = std::chrono::steady_clock::now() - start;
+    return ellapsed.count() / repeats / count;
+}
+
+void Report(const char *name, const char *lhsName, const double lhs, const char *rhsName, const double rhs)
+{
+    std::cout << name << ": " << lhsName << " " << lhs << " ns, " << rhsName << " " << rhs << " ns, x" << lhs / rhs
+              << std::endl;
+}
+} // namespace
+
+/**
+ * Compares iteration of views and owning groups the game uses for movement and collision,
+ * and switching entities on and off with a tag against Activation sets.
+ * Usage: group_benchmark [entities]
+ */
+int main(int argc, char *argv[])
+{
+    const int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+    if (count <= 0)
+    {
+        std::cerr << "Usage: group_benchmark [entities]" << std::endl;
+        return 1;
+    }
+
+    entt::registry registry;
+    Activation activation;
+    Populate(registry, activation, count);
+    activation.Disable(ActivationSet::MENU);
+
+    // Keeps collision pass from being optimized out.
+    volatile float sink = 0;
+    auto move = [&activation](const entt::entity entity, Position &pos, const Velocity &vel) {
+        if (!activation.Test(entity))
+        {
+            return;
+        }
+        pos.position.Set(pos.position.x() + vel.x * 0.016f, pos.position.y() + vel.y * 0.016f);
+    };
+    auto collide = [&sink, &activation](const entt::entity entity, const RectCollider &rect,
+                                        const CollisionLayer &layer, const Position &pos) {
+        if (!activation.Test(entity))
+        {
+            return;
+        }
+        sink = sink + pos.position.x() + rect.rect.w + static_cast<float>(layer.layer);
+    };
+
+    // Views first, creating the groups sorts the pools.
+    auto movementView = registry.view<Position, Velocity>();
+    auto colliderView = registry.view<RectCollider, CollisionLayer, Position>();
+    auto movementViewTime = Measure(count, [&] { movementView.each(move); });
+    auto colliderViewTime = Measure(count, [&] { colliderView.each(collide); });
+
+    auto movementGroup = registry.group<Position, Velocity>();
+    auto colliderGroup = registry.group<RectCollider, CollisionLayer>(entt::get<Position>);
+    auto movementGroupTime = Measure(count, [&] { movementGroup.each(move); });
+    // Like PartitionMovement and MovementUpdate: enabled movers first, then one kernel call.
+    movementGroup.sort([&activation](const entt::entity lhs, const entt::entity rhs) {
+        return !activation.Test(lhs) && activation.Test(rhs);
+    });
+    std::size_t enabled = 0;
+    while (enabled < movementGroup.size() && activation.Test(movementGroup.data()[enabled]))
+    {
+        enabled++;
+    }
+    auto batch = [&](const SimdLevel level) {
+        Simd::SetLevel(level);
+        return Measure(count, [&] {
+            Integrate(movementGroup.raw<Position>(), movementGroup.raw<Velocity>(), enabled, 0.016f);
+        });
+    };
+    auto scalarTime = batch(SimdLevel::SCALAR);
+    auto simd128Time = batch(SimdLevel::SIMD128);
+    auto simd256Time = batch(SimdLevel::SIMD256);
+    Simd::SetLevel(Simd::Supported());
+    auto colliderGroupTime = Measure(count, [&] { colliderGroup.each(collide); });
+
+    // Menu and gameplay transition: every gameplay entity off and on again.
+    std::vector<entt::entity> gameplay;
+    registry.each([&gameplay, &activation](const auto entity) {
+        if (activation.Test(entity))
+        {
+            gameplay.push_back(entity);
+        }
+    });
+    registry.assign<Tagged>(gameplay.cbegin(), gameplay.cend());
+    auto tagTime = Measure(count, [&] {
+        registry.remove<Tagged>(gameplay.cbegin(), gameplay.cend());
+        registry.assign<Tagged>(gameplay.cbegin(), gameplay.cend());
+    });
+    auto setTime = Measure(count, [&] {
+        activation.Disable(ActivationSet::GAMEPLAY);
+        activation.Enable(ActivationSet::GAMEPLAY);
+    });
+
+    std::cout << count << " entities, " << movementGroup.size() << " movers, " << colliderGroup.size()
+              << " colliders, time per registry entity" << std::endl;
+    Report("movement", "view", movementViewTime, "group", movementGroupTime);
+    Report("movement", "group", movementGroupTime, "scalar", scalarTime);
+    Report("movement", "scalar", scalarTime, "simd128", simd128Time);
+    Report("movement", "simd128", simd128Time, "simd256", simd256Time);
+    std::cout << "integration of " << enabled << " movers: " << simd256Time * count / 1e6 << " ms" << std::endl;
+    Report("collision", "view", colliderViewTime, "group", colliderGroupTime);
+    Report("toggle", "tag", tagTime, "activation", setTime);
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include "../component/tilegrid.hpp"
+#include "../resource/map_format.hpp"
+
+using namespace ssecs;
+
+/**
+ * Offline converter from Tiled map (*.tmx) to precompiled map (*.ssmap).
+ * Usage: map_compiler <input.tmx> <output.ssmap>
+ */
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: map_compiler <input.tmx> <output.ssmap>" << std::endl;
+        return 1;
+    }
+    try
+    {
+        std::ifstream input{argv[1], std::ios::binary};
+        if (!input.is_open())
+        {
+            FAST_THROW("Could't open input file.");
+        }
+        std::vector<char> source{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+
+        pugi::xml_document document;
+        auto result = document.load_buffer(source.data(), source.size());
+        if (!result)
+        {
+            FAST_THROW(result.description());
+        }
+        auto map = document.child("map");
+
+        // Cells only, tile rects aren't needed.
+        component::TileSet tileset;
+        std::vector<component::TileGrid> grids;
+        std::vector<resource::map_layer> layers;
+        for (auto layer : map.children("layer"))
+        {
+            resource::map_layer entry{};
+            entry.id = static_cast<std::uint32_t>(std::stoul(layer.attribute("id").value()));
+            std::strncpy(entry.name, layer.attribute("name").value(), sizeof(entry.name) - 1);
+            grids.emplace_back(document, &tileset, entry.id);
+            layers.push_back(entry);
+        }
+
+        std::vector<resource::map_tileset> tilesets;
+        for (auto set : map.children("tileset"))
+        {
+            resource::map_tileset entry{};
+            entry.first_gid = static_cast<std::uint32_t>(std::stoul(set.attribute("firstgid").value()));
+            std::strncpy(entry.source, set.attribute("source").value(), sizeof(entry.source) - 1);
+            tilesets.push_back(entry);
+        }
+
+        resource::map_header header{};
+        std::memcpy(header.magic, resource::map_magic, sizeof(header.magic));
+        header.version = resource::map_version;
+        header.width = static_cast<std::uint32_t>(std::stoul(map.attribute("width").value()));
+        header.height = static_cast<std::uint32_t>(std::stoul(map.attribute("height").value()));
+        header.layer_count = static_cast<std::uint32_t>(layers.size());
+        header.tileset_count = static_cast<std::uint32_t>(tilesets.size());
+        header.id_size = sizeof(component::TileGrid::id_type);
+        header.row_words = grids.empty() ? 0 : static_cast<std::uint32_t>(grids.front().RowWords());
+        header.source_size = source.size();
+        header.source_hash = resource::map_source_hash(source.data(), source.size());
+
+        auto align = [](std::size_t offset) { return (offset + 3) & ~std::size_t{3}; };
+        auto offset = sizeof(header) + tilesets.size() * sizeof(resource::map_tileset) +
+                      layers.size() * sizeof(resource::map_layer);
+        for (std::size_t index = 0; index < layers.size(); index++)
+        {
+            auto &grid = grids[index];
+            layers[index].cells_offset = static_cast<std::uint32_t>(offset);
+            offset = align(offset + grid.Cells().size() * sizeof(component::TileGrid::id_type));
+            layers[index].solid_offset = static_cast<std::uint32_t>(offset);
+            offset += grid.SolidWords().size() * sizeof(component::TileGrid::word_type);
+        }
+
+        std::ofstream file{argv[2], std::ios::binary | std::ios::trunc};
+        if (!file.is_open())
+        {
+            FAST_THROW("Could't open output file.");
+        }
+        auto write = [&file](const void *data, std::size_t size) {
+            file.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+        };
+        write(&header, sizeof(header));
+        write(tilesets.data(), tilesets.size() * sizeof(resource::map_tileset));
+        write(layers.data(), layers.size() * sizeof(resource::map_layer));
+        for (auto &grid : grids)
+        {
+            const char padding[4]{};
+            auto cells = grid.Cells().size() * sizeof(component::TileGrid::id_type);
+            write(grid.Cells().data(), cells);
+            write(padding, align(cells) - cells);
+            write(grid.SolidWords().data(), grid.SolidWords().size() * sizeof(component::TileGrid::word_type));
+        }
+        std::cout << argv[2] << ": " << header.width << "x" << header.height << ", " << layers.size() << " layers"
+                  << std::endl;
+        return 0;
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}